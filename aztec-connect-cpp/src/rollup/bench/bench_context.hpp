@@ -0,0 +1,144 @@
+#pragma once
+#include "../fixtures/test_context.hpp"
+#include "../proofs/rollup/index.hpp"
+#include "../proofs/root_rollup/index.hpp"
+#include "../proofs/mapped_reference_string_factory.hpp"
+#include "../proofs/prover_context.hpp"
+#include <benchmark/benchmark.h>
+#include <map>
+
+/**
+ * What the benchmarks share: the reference string, circuit data, and the client proofs the rollup benchmarks roll up.
+ * Each is computed (or loaded from DATA_PATH) the first time a benchmark asks for it, before its timed loop starts.
+ */
+namespace rollup {
+namespace bench {
+
+using namespace ::rollup::proofs;
+using WorldState = fixtures::WorldState;
+
+constexpr auto CRS_PATH = "../barretenberg/cpp/srs_db/ignition";
+constexpr auto DATA_PATH = "./data";
+
+inline std::shared_ptr<waffle::ReferenceStringFactory> const& get_srs()
+{
+    static std::shared_ptr<waffle::ReferenceStringFactory> srs =
+        std::make_shared<mapped_reference_string_factory>(CRS_PATH, DATA_PATH);
+    return srs;
+}
+
+struct client_circuit_data {
+    join_split::circuit_data join_split;
+    account::circuit_data account;
+    claim::circuit_data claim;
+};
+
+// Real keys to prove client txs with, or mock keys for the client proofs the rollup benchmarks roll up.
+inline client_circuit_data const& get_client_circuit_data(bool mock)
+{
+    static std::map<bool, client_circuit_data> cache;
+    auto it = cache.find(mock);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    auto& cd = cache[mock];
+    cd.join_split = join_split::get_circuit_data(get_srs(), mock, DATA_PATH, true, true, true);
+    cd.account = account::get_circuit_data(get_srs(), mock, DATA_PATH, true, true, true);
+    cd.claim = claim::get_circuit_data(get_srs(), mock, DATA_PATH, true, true, true);
+    return cd;
+}
+
+/**
+ * A tx rollup over mock client proofs. Only the last one asked for is held, as the keys of the larger rollups take
+ * several gigabytes.
+ */
+inline proofs::rollup::circuit_data const& get_tx_rollup_circuit_data(size_t num_txs, bool mock)
+{
+    static proofs::rollup::circuit_data cd;
+    if (!cd.proving_key || cd.num_txs != num_txs || cd.mock != mock) {
+        cd = {};
+        auto const& client_cd = get_client_circuit_data(true);
+        cd = proofs::rollup::get_circuit_data(num_txs,
+                                              client_cd.join_split,
+                                              client_cd.account,
+                                              client_cd.claim,
+                                              get_srs(),
+                                              DATA_PATH,
+                                              true,
+                                              true,
+                                              true,
+                                              true,
+                                              true,
+                                              mock);
+    }
+    return cd;
+}
+
+/**
+ * Mock deposit proofs over the empty data tree, each spending its own random nullifiers, so any number of them can be
+ * rolled up together. Verifying a mock proof costs the rollup circuit as much as a real one.
+ */
+inline std::vector<std::vector<uint8_t>> const& get_deposit_proofs(size_t num_proofs)
+{
+    static std::vector<std::vector<uint8_t>> deposits;
+    if (deposits.size() >= num_proofs) {
+        return deposits;
+    }
+    auto const& client_cd = get_client_circuit_data(true);
+    fixtures::TestContext context(client_cd.join_split, client_cd.account, client_cd.claim);
+    prover_context<join_split::join_split_tx> prover(
+        client_cd.join_split.proving_key, join_split::join_split_circuit, true);
+    while (deposits.size() < num_proofs) {
+        auto tx = context.js_tx_factory.create_join_split_tx({}, {}, { 100, 50 }, 150);
+        context.js_tx_factory.finalise_and_sign_tx(tx, context.user.owner);
+        deposits.push_back(prover.prove(tx));
+    }
+    return deposits;
+}
+
+// As the tx rollup's verify does, but on a composer the benchmark owns, so building and proving can be timed apart.
+inline void build_tx_rollup(circuit_types::Composer& composer,
+                            proofs::rollup::rollup_tx tx,
+                            proofs::rollup::circuit_data const& cd)
+{
+    proofs::rollup::pad_rollup_tx(tx, cd.num_txs, cd.join_split_circuit_data.padding_proof);
+    proofs::rollup::rollup_circuit(composer,
+                                   tx,
+                                   cd.verification_keys,
+                                   cd.num_txs,
+                                   cd.chaining_check,
+                                   cd.nullifier_tree,
+                                   cd.slot_matching,
+                                   cd.membership_checks);
+}
+
+inline void build_root_rollup(circuit_types::Composer& composer,
+                              proofs::root_rollup::root_rollup_tx tx,
+                              proofs::root_rollup::circuit_data const& cd)
+{
+    proofs::root_rollup::pad_root_rollup_tx(tx, cd);
+    proofs::root_rollup::root_rollup_circuit(composer,
+                                             tx,
+                                             cd.inner_rollup_circuit_data.rollup_size,
+                                             cd.rollup_size,
+                                             cd.inner_rollup_circuit_data.verification_key,
+                                             cd.slot_matching);
+}
+
+inline std::vector<uint8_t> prove(circuit_types::Composer& composer)
+{
+    if (composer.failed) {
+        throw_or_abort(format("composer logic failed: ", composer.err));
+    }
+    auto prover = composer.create_unrolled_prover();
+    return prover.construct_proof().proof_data;
+}
+
+// Circuit benchmarks report the gate count of the circuit they build or prove.
+inline void report_circuit(benchmark::State& state, size_t num_gates)
+{
+    state.counters["gates"] = static_cast<double>(num_gates);
+}
+
+} // namespace bench
+} // namespace rollup
@@ -0,0 +1,135 @@
+#include "bench_context.hpp"
+
+/**
+ * Building and proving the client circuits, with their real keys. Proving times exclude building the circuit.
+ */
+namespace rollup {
+namespace bench {
+namespace {
+
+template <typename Tx> using circuit_builder = void (*)(circuit_types::Composer&, Tx const&);
+
+template <typename Tx>
+void bench_build(benchmark::State& state, proofs::circuit_data const& cd, circuit_builder<Tx> build, Tx const& tx)
+{
+    size_t num_gates = 0;
+    for (auto _ : state) {
+        circuit_types::Composer composer(cd.proving_key, cd.verification_key, cd.num_gates);
+        reserve_witness_capacity(composer, cd);
+        build(composer, tx);
+        num_gates = composer.get_num_gates();
+    }
+    report_circuit(state, num_gates);
+}
+
+template <typename Tx>
+void bench_prove(benchmark::State& state, proofs::circuit_data const& cd, circuit_builder<Tx> build, Tx const& tx)
+{
+    size_t num_gates = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        circuit_types::Composer composer(cd.proving_key, cd.verification_key, cd.num_gates);
+        reserve_witness_capacity(composer, cd);
+        build(composer, tx);
+        num_gates = composer.get_num_gates();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(prove(composer));
+    }
+    report_circuit(state, num_gates);
+}
+
+// A send, spending two value notes.
+join_split::join_split_tx create_join_split_tx(fixtures::TestContext& context)
+{
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto tx = context.js_tx_factory.create_join_split_tx({ 0, 1 }, { 100, 50 }, { 70, 80 });
+    context.js_tx_factory.finalise_and_sign_tx(tx, context.user.owner);
+    return tx;
+}
+
+account::account_tx create_account_tx(fixtures::TestContext& context)
+{
+    auto tx = context.account_tx_factory.create_new_account_tx();
+    tx.sign(context.user.owner);
+    return tx;
+}
+
+claim::claim_tx create_claim_tx(fixtures::TestContext& context)
+{
+    notes::native::claim::claim_note note = {
+        .deposit_value = 10,
+        .bridge_call_data = 0,
+        .defi_interaction_nonce = 0,
+        .fee = 0,
+        .value_note_partial_commitment = notes::native::value::create_partial_commitment(
+            context.user.note_secret, context.user.owner.public_key, 0, 0),
+        .input_nullifier = barretenberg::fr::random_element(),
+    };
+    notes::native::defi_interaction::note interaction_note = {
+        .bridge_call_data = 0,
+        .interaction_nonce = 0,
+        .total_input_value = 100,
+        .total_output_value_a = 200,
+        .total_output_value_b = 300,
+        .interaction_result = true,
+    };
+    context.world_state.append_data_note(note);
+    context.world_state.add_defi_notes({ interaction_note }, 0);
+    return context.claim_tx_factory.create_claim_tx(
+        context.world_state.defi_tree.root(), 0, 0, note, interaction_note);
+}
+
+void join_split_build(benchmark::State& state)
+{
+    auto const& cd = get_client_circuit_data(false);
+    fixtures::TestContext context(cd.join_split, cd.account, cd.claim);
+    bench_build(state, cd.join_split, join_split::join_split_circuit, create_join_split_tx(context));
+}
+
+void join_split_prove(benchmark::State& state)
+{
+    auto const& cd = get_client_circuit_data(false);
+    fixtures::TestContext context(cd.join_split, cd.account, cd.claim);
+    bench_prove(state, cd.join_split, join_split::join_split_circuit, create_join_split_tx(context));
+}
+
+void account_build(benchmark::State& state)
+{
+    auto const& cd = get_client_circuit_data(false);
+    fixtures::TestContext context(cd.join_split, cd.account, cd.claim);
+    bench_build(state, cd.account, account::account_circuit, create_account_tx(context));
+}
+
+void account_prove(benchmark::State& state)
+{
+    auto const& cd = get_client_circuit_data(false);
+    fixtures::TestContext context(cd.join_split, cd.account, cd.claim);
+    bench_prove(state, cd.account, account::account_circuit, create_account_tx(context));
+}
+
+void claim_build(benchmark::State& state)
+{
+    auto const& cd = get_client_circuit_data(false);
+    fixtures::TestContext context(cd.join_split, cd.account, cd.claim);
+    bench_build(state, cd.claim, claim::claim_circuit, create_claim_tx(context));
+}
+
+void claim_prove(benchmark::State& state)
+{
+    auto const& cd = get_client_circuit_data(false);
+    fixtures::TestContext context(cd.join_split, cd.account, cd.claim);
+    bench_prove(state, cd.claim, claim::claim_circuit, create_claim_tx(context));
+}
+
+} // namespace
+
+BENCHMARK(join_split_build)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(join_split_prove)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(account_build)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(account_prove)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(claim_build)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(claim_prove)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace bench
+} // namespace rollup
@@ -0,0 +1,49 @@
+#include "../proofs/compute_circuit_data.hpp"
+#include "../proofs/circuit_types.hpp"
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <thread>
+#ifndef NO_MULTITHREADING
+#include <omp.h>
+#endif
+
+namespace {
+// The processor's name, which google benchmark's own context leaves out.
+std::string get_cpu_model()
+{
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            auto pos = line.find(':');
+            return pos == std::string::npos ? "" : line.substr(std::min(pos + 2, line.size()));
+        }
+    }
+    return "unknown";
+}
+} // namespace
+
+/**
+ * Runs the benchmarks, recording alongside their results what they ran on: the machine's CPU and the threads the
+ * provers use. Run with `--benchmark_out=<file> --benchmark_out_format=json` (or `make run_rollup_bench`) for JSON.
+ */
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+#ifndef NO_MULTITHREADING
+    benchmark::AddCustomContext("multithreading", "true");
+    benchmark::AddCustomContext("num_threads", std::to_string(omp_get_max_threads()));
+#else
+    benchmark::AddCustomContext("multithreading", "false");
+    benchmark::AddCustomContext("num_threads", "1");
+#endif
+    benchmark::AddCustomContext("hardware_concurrency", std::to_string(std::thread::hardware_concurrency()));
+    benchmark::AddCustomContext("cpu_model", get_cpu_model());
+    benchmark::AddCustomContext("composer", GET_COMPOSER_NAME_STRING(::rollup::proofs::circuit_types::Composer));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
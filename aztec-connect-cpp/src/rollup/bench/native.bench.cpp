@@ -0,0 +1,192 @@
+#include "bench_context.hpp"
+#include <common/serialize.hpp>
+
+extern "C" void notes__batch_decrypt_notes(uint8_t const* encrypted_notes_buffer,
+                                           uint8_t* private_key_buffer,
+                                           uint32_t numKeys,
+                                           uint8_t* output);
+
+/**
+ * The native work around the circuits: what a rollup provider does to create a rollup's tx, the note commitments and
+ * nullifiers clients and the provider compute, decrypting notes, and updating and reading the world state's trees.
+ */
+namespace rollup {
+namespace bench {
+namespace {
+
+using namespace barretenberg;
+
+constexpr size_t AES_CIPHERTEXT_LENGTH = 80;
+constexpr size_t ENCRYPTED_NOTE_LENGTH = AES_CIPHERTEXT_LENGTH + 64;
+constexpr size_t DECRYPTED_NOTE_LENGTH = 73;
+
+notes::native::value::value_note create_value_note()
+{
+    return { .value = 100,
+             .asset_id = 0,
+             .account_required = false,
+             .owner = grumpkin::g1::affine_element(grumpkin::g1::element::random_element()),
+             .secret = fr::random_element(),
+             .creator_pubkey = 0,
+             .input_nullifier = fr::random_element() };
+}
+
+void create_rollup_tx(benchmark::State& state)
+{
+    auto num_txs = static_cast<size_t>(state.range(0));
+    auto const& deposits = get_deposit_proofs(num_txs);
+    std::vector<std::vector<uint8_t>> txs(deposits.begin(), deposits.begin() + static_cast<std::ptrdiff_t>(num_txs));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world_state = std::make_unique<WorldState>();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(proofs::rollup::create_rollup_tx(*world_state, num_txs, txs));
+        state.PauseTiming();
+        world_state.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void value_note_commit(benchmark::State& state)
+{
+    auto note = create_value_note();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(note.commit());
+    }
+}
+
+void account_note_commit(benchmark::State& state)
+{
+    notes::native::account::account_note note = {
+        .alias_hash = fr::random_element(),
+        .owner_key = grumpkin::g1::affine_element(grumpkin::g1::element::random_element()),
+        .signing_key = grumpkin::g1::affine_element(grumpkin::g1::element::random_element()),
+    };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(note.commit());
+    }
+}
+
+// Completes the partial commitment a defi deposit creates, as the rollup provider does once the interaction's nonce
+// and fee are known.
+void claim_note_commit(benchmark::State& state)
+{
+    notes::native::claim::claim_note note = {
+        .deposit_value = 10,
+        .bridge_call_data = 0,
+        .defi_interaction_nonce = 0,
+        .fee = 0,
+        .value_note_partial_commitment = fr::random_element(),
+        .input_nullifier = fr::random_element(),
+    };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(note.commit());
+    }
+}
+
+void defi_interaction_note_commit(benchmark::State& state)
+{
+    notes::native::defi_interaction::note note = {
+        .bridge_call_data = 0,
+        .interaction_nonce = 0,
+        .total_input_value = 100,
+        .total_output_value_a = 200,
+        .total_output_value_b = 300,
+        .interaction_result = true,
+    };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(note.commit());
+    }
+}
+
+void value_note_nullifier(benchmark::State& state)
+{
+    auto commitment = create_value_note().commit();
+    auto private_key = grumpkin::fr::random_element();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(notes::native::compute_nullifier(commitment, private_key, true));
+    }
+}
+
+void claim_note_nullifier(benchmark::State& state)
+{
+    auto commitment = fr::random_element();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(notes::native::claim::compute_nullifier(commitment));
+    }
+}
+
+// Notes encrypted to random ephemeral keys decrypt to garbage, for the same work as a user's own notes.
+void batch_decrypt_notes(benchmark::State& state)
+{
+    auto num_notes = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> encrypted_notes(num_notes * ENCRYPTED_NOTE_LENGTH);
+    for (size_t i = 0; i < num_notes; ++i) {
+        uint8_t* it = &encrypted_notes[i * ENCRYPTED_NOTE_LENGTH];
+        for (size_t j = 0; j < AES_CIPHERTEXT_LENGTH; ++j) {
+            *it++ = numeric::random::get_engine().get_random_uint8();
+        }
+        write(it, grumpkin::g1::affine_element(grumpkin::g1::element::random_element()));
+    }
+    auto private_key = to_buffer(grumpkin::fr::random_element());
+    std::vector<uint8_t> output(num_notes * DECRYPTED_NOTE_LENGTH);
+    for (auto _ : state) {
+        notes__batch_decrypt_notes(
+            encrypted_notes.data(), private_key.data(), static_cast<uint32_t>(num_notes), output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void data_tree_append(benchmark::State& state)
+{
+    WorldState world_state;
+    auto note = create_value_note();
+    for (auto _ : state) {
+        note.input_nullifier += 1;
+        world_state.append_data_note(note);
+    }
+}
+
+// Hash paths of notes in a data tree holding the given number of them.
+void data_tree_get_hash_path(benchmark::State& state)
+{
+    auto num_notes = static_cast<size_t>(state.range(0));
+    WorldState world_state;
+    auto note = create_value_note();
+    for (size_t i = 0; i < num_notes; ++i) {
+        note.input_nullifier += 1;
+        world_state.append_data_note(note);
+    }
+    size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(world_state.data_tree.get_hash_path(index));
+        index = (index + 1) % num_notes;
+    }
+}
+
+void nullify(benchmark::State& state)
+{
+    WorldState world_state;
+    for (auto _ : state) {
+        world_state.nullify(uint256_t(fr::random_element()));
+    }
+}
+
+} // namespace
+
+BENCHMARK(create_rollup_tx)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond);
+BENCHMARK(value_note_commit)->Unit(benchmark::kMicrosecond);
+BENCHMARK(account_note_commit)->Unit(benchmark::kMicrosecond);
+BENCHMARK(claim_note_commit)->Unit(benchmark::kMicrosecond);
+BENCHMARK(defi_interaction_note_commit)->Unit(benchmark::kMicrosecond);
+BENCHMARK(value_note_nullifier)->Unit(benchmark::kMicrosecond);
+BENCHMARK(claim_note_nullifier)->Unit(benchmark::kMicrosecond);
+BENCHMARK(batch_decrypt_notes)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(data_tree_append)->Unit(benchmark::kMicrosecond);
+BENCHMARK(data_tree_get_hash_path)->RangeMultiplier(16)->Range(16, 16384)->Unit(benchmark::kMicrosecond);
+BENCHMARK(nullify)->Unit(benchmark::kMicrosecond);
+
+} // namespace bench
+} // namespace rollup
@@ -0,0 +1,145 @@
+#include "bench_context.hpp"
+
+/**
+ * Building and proving the tx and root rollup circuits, with their real keys, over mock client and inner rollup
+ * proofs. Proving times exclude building the circuit.
+ */
+namespace rollup {
+namespace bench {
+namespace {
+
+// Of the tx rollups the root rollup benchmarks roll up. The root rollup's cost is in verifying them, not their txs.
+constexpr size_t INNER_ROLLUP_SIZE = 1;
+
+// A full tx rollup of deposits, over a world state of its own.
+proofs::rollup::rollup_tx create_tx_rollup(size_t num_txs)
+{
+    auto const& deposits = get_deposit_proofs(num_txs);
+    WorldState world_state;
+    return proofs::rollup::create_rollup_tx(
+        world_state, num_txs, { deposits.begin(), deposits.begin() + static_cast<std::ptrdiff_t>(num_txs) });
+}
+
+// Only the last one asked for is held, as with the tx rollups.
+proofs::root_rollup::circuit_data const& get_root_rollup_circuit_data(size_t num_inner_rollups)
+{
+    static proofs::root_rollup::circuit_data cd;
+    if (!cd.proving_key || cd.num_inner_rollups != num_inner_rollups) {
+        cd = {};
+        auto const& tx_rollup_cd = get_tx_rollup_circuit_data(INNER_ROLLUP_SIZE, true);
+        cd = proofs::root_rollup::get_circuit_data(
+            num_inner_rollups, tx_rollup_cd, get_srs(), DATA_PATH, true, true, true, true, true, false);
+    }
+    return cd;
+}
+
+/**
+ * Rolls up `num_inner_rollups` tx rollups of a deposit each, proven with mock keys, over a world state of its own.
+ * The inner proofs are only computed once per count.
+ */
+proofs::root_rollup::root_rollup_tx create_root_rollup_tx(size_t num_inner_rollups)
+{
+    static std::map<size_t, proofs::root_rollup::root_rollup_tx> cache;
+    auto it = cache.find(num_inner_rollups);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    auto const& deposits = get_deposit_proofs(num_inner_rollups);
+    auto const& tx_rollup_cd = get_tx_rollup_circuit_data(INNER_ROLLUP_SIZE, true);
+    prover_context<proofs::rollup::rollup_tx> prover(
+        tx_rollup_cd.proving_key,
+        [&](circuit_types::Composer& composer, proofs::rollup::rollup_tx const& tx) {
+            build_tx_rollup(composer, tx, tx_rollup_cd);
+        },
+        true);
+
+    WorldState world_state;
+    auto old_defi_root = world_state.defi_tree.root();
+    auto old_defi_path = world_state.defi_tree.get_hash_path(0);
+    std::vector<std::vector<uint8_t>> inner_proofs;
+    for (size_t i = 0; i < num_inner_rollups; ++i) {
+        auto tx = proofs::rollup::create_rollup_tx(world_state, INNER_ROLLUP_SIZE, { deposits[i] });
+        inner_proofs.push_back(prover.prove(tx));
+    }
+    return cache[num_inner_rollups] =
+               proofs::root_rollup::create_root_rollup_tx(world_state, 0, old_defi_root, old_defi_path, inner_proofs);
+}
+
+void tx_rollup_build(benchmark::State& state)
+{
+    auto num_txs = static_cast<size_t>(state.range(0));
+    auto const& cd = get_tx_rollup_circuit_data(num_txs, false);
+    auto tx = create_tx_rollup(num_txs);
+    size_t num_gates = 0;
+    for (auto _ : state) {
+        circuit_types::Composer composer(cd.proving_key, cd.verification_key, cd.num_gates);
+        reserve_witness_capacity(composer, cd);
+        build_tx_rollup(composer, tx, cd);
+        num_gates = composer.get_num_gates();
+    }
+    report_circuit(state, num_gates);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void tx_rollup_prove(benchmark::State& state)
+{
+    auto num_txs = static_cast<size_t>(state.range(0));
+    auto const& cd = get_tx_rollup_circuit_data(num_txs, false);
+    auto tx = create_tx_rollup(num_txs);
+    size_t num_gates = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        circuit_types::Composer composer(cd.proving_key, cd.verification_key, cd.num_gates);
+        reserve_witness_capacity(composer, cd);
+        build_tx_rollup(composer, tx, cd);
+        num_gates = composer.get_num_gates();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(prove(composer));
+    }
+    report_circuit(state, num_gates);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void root_rollup_build(benchmark::State& state)
+{
+    auto num_inner_rollups = static_cast<size_t>(state.range(0));
+    auto tx = create_root_rollup_tx(num_inner_rollups);
+    auto const& cd = get_root_rollup_circuit_data(num_inner_rollups);
+    size_t num_gates = 0;
+    for (auto _ : state) {
+        circuit_types::Composer composer(cd.proving_key, cd.verification_key, cd.num_gates);
+        reserve_witness_capacity(composer, cd);
+        build_root_rollup(composer, tx, cd);
+        num_gates = composer.get_num_gates();
+    }
+    report_circuit(state, num_gates);
+}
+
+void root_rollup_prove(benchmark::State& state)
+{
+    auto num_inner_rollups = static_cast<size_t>(state.range(0));
+    auto tx = create_root_rollup_tx(num_inner_rollups);
+    auto const& cd = get_root_rollup_circuit_data(num_inner_rollups);
+    size_t num_gates = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        circuit_types::Composer composer(cd.proving_key, cd.verification_key, cd.num_gates);
+        reserve_witness_capacity(composer, cd);
+        build_root_rollup(composer, tx, cd);
+        num_gates = composer.get_num_gates();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(prove(composer));
+    }
+    report_circuit(state, num_gates);
+}
+
+} // namespace
+
+BENCHMARK(tx_rollup_build)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(tx_rollup_prove)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(root_rollup_build)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(root_rollup_prove)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace bench
+} // namespace rollup
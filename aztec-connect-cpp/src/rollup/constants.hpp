@@ -10,6 +10,8 @@ constexpr size_t DATA_TREE_DEPTH = 32;
 constexpr size_t NULL_TREE_DEPTH = 256;
 constexpr size_t ROOT_TREE_DEPTH = 28;
 constexpr size_t DEFI_TREE_DEPTH = 30;
+// Depth of the indexed (low-nullifier) alternative to the sparse nullifier tree. See `world_state/indexed_tree.hpp`.
+constexpr size_t INDEXED_NULL_TREE_DEPTH = 32;
 
 constexpr size_t MAX_NO_WRAP_INTEGER_BIT_LENGTH = grumpkin::MAX_NO_WRAP_INTEGER_BIT_LENGTH;
 constexpr size_t MAX_TXS_BIT_LENGTH = 10;
@@ -0,0 +1,524 @@
+#pragma once
+#include "test_context.hpp"
+#include "../proofs/prover_context.hpp"
+#include "../proofs/rollup/index.hpp"
+#include "../proofs/root_rollup/index.hpp"
+#include <common/log.hpp>
+#include <common/throw_or_abort.hpp>
+#include <deque>
+#include <optional>
+#include <random>
+#include <tuple>
+
+namespace rollup {
+namespace fixtures {
+
+/**
+ * The shape of the load a `tx_mix_generator` produces.
+ *
+ * Kinds of tx are drawn with the given relative weights. A defi deposit can be claimed from the block after the one
+ * it's rolled up in, when its interaction's result is known. While any are claimable, claims are drawn along with the
+ * other kinds with the defi deposits' weight, so they're claimed as often as made, in the order they were made.
+ */
+struct tx_mix {
+    double deposit_weight = 25;
+    double send_weight = 35;
+    double withdraw_weight = 15;
+    double defi_deposit_weight = 20;
+    double account_weight = 5;
+    // The fraction of sends that start a chain of txs, each spending an output note of the one before.
+    double chain_ratio = 0.2;
+    // The mean length of a chain, of at least 2 txs. Chains are cut short at the end of a rollup.
+    double mean_chain_length = 3;
+    // The fraction of txs spending notes that spend two of them rather than one.
+    double two_input_ratio = 0.5;
+    // Asset ids 0 to `num_asset_ids - 1` are used, at most NUM_ASSETS of them.
+    uint32_t num_asset_ids = 3;
+    // Bridges are spread over the assets. At most NUM_BRIDGE_CALLS_PER_BLOCK of them.
+    uint32_t num_bridge_call_datas = 8;
+    // The notes of each asset the user starts with.
+    uint32_t notes_per_asset = 16;
+    uint32_t max_note_value = 10000;
+    uint32_t max_fee = 10;
+    uint64_t seed = 0;
+};
+
+// The txs of each kind generated so far.
+struct tx_mix_counts {
+    size_t deposits = 0;
+    size_t sends = 0;
+    size_t withdraws = 0;
+    size_t defi_deposits = 0;
+    size_t claims = 0;
+    size_t accounts = 0;
+    // Of the above, those spending an output note of the tx before them in their rollup.
+    size_t chained = 0;
+};
+
+/**
+ * Generates blocks of a realistic mix of txs for load testing the rollup circuits: deposits, sends and withdrawals of
+ * several assets, with one or two input notes, chains of txs, defi deposits through many bridges and their claims, and
+ * account txs. Each block is the inner rollups of a root rollup, with the root rollup following once they're proven.
+ *
+ * Txs are built with the factories of a `TestContext` and proven with its circuits' keys, as mock proofs if they're
+ * mock circuits. Notes output by a block are spent by later ones. The context's user starts with `notes_per_asset`
+ * notes of each asset, and the context's next root rollup is started for the first block.
+ */
+class tx_mix_generator {
+  public:
+    tx_mix_generator(TestContext& context, tx_mix const& mix)
+        : context_(context)
+        , mix_(mix)
+        , engine_(mix.seed)
+        , kinds_({ mix.deposit_weight,
+                   mix.send_weight,
+                   mix.withdraw_weight,
+                   mix.defi_deposit_weight,
+                   mix.account_weight })
+        , kinds_with_claims_({ mix.deposit_weight,
+                               mix.send_weight,
+                               mix.withdraw_weight,
+                               mix.defi_deposit_weight,
+                               mix.account_weight,
+                               mix.defi_deposit_weight })
+        , js_prover_(context.js_cd.proving_key, join_split::join_split_circuit, context.js_cd.mock)
+        , account_prover_(context.account_cd.proving_key, account::account_circuit, context.account_cd.mock)
+        , claim_prover_(context.claim_cd.proving_key, claim::claim_circuit, context.claim_cd.mock)
+    {
+        if (mix.num_asset_ids == 0 || mix.num_asset_ids > NUM_ASSETS) {
+            throw_or_abort(format("Number of asset ids must be between 1 and ", NUM_ASSETS, "."));
+        }
+        if (mix.num_bridge_call_datas > NUM_BRIDGE_CALLS_PER_BLOCK) {
+            throw_or_abort(format("Number of bridge call datas must be at most ", NUM_BRIDGE_CALLS_PER_BLOCK, "."));
+        }
+
+        auto& data_tree = context.world_state.data_tree;
+        for (uint32_t asset_id = 0; asset_id < mix.num_asset_ids; ++asset_id) {
+            asset_ids_.push_back(asset_id);
+            for (uint32_t i = 0; i < mix.notes_per_asset; ++i) {
+                auto value = uniform(1, mix.max_note_value);
+                notes_.push_back({ static_cast<uint32_t>(data_tree.size()), value, asset_id });
+                context.append_value_notes({ value }, asset_id);
+            }
+        }
+        account_note_index_ = static_cast<uint32_t>(data_tree.size());
+        context.append_account_notes();
+
+        for (uint32_t i = 0; i < mix.num_bridge_call_datas; ++i) {
+            const notes::native::bridge_call_data bid = {
+                .bridge_address_id = i + 1,
+                .input_asset_id_a = i % mix.num_asset_ids,
+                .input_asset_id_b = 0,
+                .output_asset_id_a = (i + 1) % mix.num_asset_ids,
+                .output_asset_id_b = 0,
+                .config = notes::native::bridge_call_data::bit_config{ .second_input_in_use = false,
+                                                                       .second_output_in_use = false },
+                .aux_data = 0
+            };
+            bridges_.push_back(bid);
+        }
+
+        context.start_next_root_rollup();
+    }
+
+    /**
+     * The inner rollups of the next block, of `rollup_size` txs each, holding `num_txs[i]` txs for the i'th. Must be
+     * followed by `create_root_rollup_tx`, before the next block.
+     */
+    std::vector<proofs::rollup::rollup_tx> create_rollup_txs(size_t rollup_size, std::vector<size_t> const& num_txs)
+    {
+        if (in_block_) {
+            throw_or_abort("The root rollup of the last block hasn't been created.");
+        }
+        in_block_ = true;
+        start_block();
+
+        // Every tx of the block is built against the block's data root, so before any of its rollups are.
+        std::vector<std::vector<std::vector<uint8_t>>> rollup_txs(num_txs.size());
+        for (size_t i = 0; i < num_txs.size(); ++i) {
+            block_rollup_ = i;
+            while (rollup_txs[i].size() < num_txs[i]) {
+                add_txs(rollup_txs[i], num_txs[i] - rollup_txs[i].size());
+            }
+        }
+
+        std::vector<proofs::rollup::rollup_tx> rollups;
+        std::vector<uint32_t> data_start_indices;
+        for (auto const& txs : rollup_txs) {
+            rollups.push_back(
+                proofs::rollup::create_rollup_tx(context_.world_state, rollup_size, txs, block_bridges_, asset_ids_));
+            data_start_indices.push_back(rollups.back().data_start_index);
+        }
+
+        // Outputs become spendable, and deposits claimable, in the next block.
+        for (auto const& note : block_notes_) {
+            next_notes_.push_back({ data_start_indices[note.rollup] + note.offset, note.value, note.asset_id });
+        }
+        auto first_defi_note_index = static_cast<uint32_t>((rollup_id_ + 1) * NUM_INTERACTION_RESULTS_PER_BLOCK);
+        for (auto const& deposit : block_deposits_) {
+            claims_.push_back({ block_bridges_[deposit.bridge],
+                                deposit.value,
+                                data_start_indices[deposit.rollup] + deposit.offset,
+                                first_defi_note_index + deposit.bridge,
+                                deposit.fee });
+        }
+        // Every bridge returns as much as was deposited into it.
+        next_interaction_notes_.clear();
+        for (size_t i = 0; i < block_bridges_.size(); ++i) {
+            next_interaction_notes_.push_back({ block_bridges_[i], 0, bridge_totals_[i], bridge_totals_[i], 0, true });
+        }
+
+        info("Block ", rollup_id_, " calls ", block_bridges_.size(), " bridges. Txs so far: ", counts_.deposits,
+             " deposits, ", counts_.sends, " sends, ", counts_.withdraws, " withdrawals, ", counts_.defi_deposits,
+             " defi deposits, ", counts_.claims, " claims, ", counts_.accounts, " account txs, ", counts_.chained,
+             " of them chained.");
+        return rollups;
+    }
+
+    // The root rollup of the block, given the proofs of its inner rollups.
+    proofs::root_rollup::root_rollup_tx create_root_rollup_tx(std::vector<std::vector<uint8_t>> const& inner_rollups)
+    {
+        if (!in_block_) {
+            throw_or_abort("No block to create the root rollup of.");
+        }
+        in_block_ = false;
+        auto tx = proofs::root_rollup::create_root_rollup_tx(context_.world_state,
+                                                             rollup_id_,
+                                                             old_defi_root_,
+                                                             old_defi_path_,
+                                                             inner_rollups,
+                                                             block_bridges_,
+                                                             asset_ids_,
+                                                             interaction_notes_);
+        notes_.insert(notes_.end(), next_notes_.begin(), next_notes_.end());
+        next_notes_.clear();
+        return tx;
+    }
+
+    tx_mix_counts const& counts() const { return counts_; }
+
+  private:
+    enum tx_kind { DEPOSIT, SEND, WITHDRAW, DEFI_DEPOSIT, ACCOUNT, CLAIM };
+
+    struct note {
+        uint32_t index;
+        uint32_t value;
+        uint32_t asset_id;
+    };
+
+    // An output note of a tx of this block, `offset` leaves into its rollup's data.
+    struct block_note {
+        size_t rollup;
+        uint32_t offset;
+        uint32_t value;
+        uint32_t asset_id;
+    };
+
+    struct block_deposit {
+        size_t rollup;
+        uint32_t offset;
+        uint32_t bridge;
+        uint32_t value;
+        uint32_t fee;
+    };
+
+    struct pending_claim {
+        uint256_t bridge_call_data;
+        uint32_t deposit_value;
+        uint32_t claim_note_index;
+        uint32_t defi_note_index;
+        uint32_t fee;
+    };
+
+    void start_block()
+    {
+        auto& world_state = context_.world_state;
+        rollup_id_ = static_cast<uint32_t>(world_state.root_tree.size() - 1);
+        auto first_defi_note_index = rollup_id_ * NUM_INTERACTION_RESULTS_PER_BLOCK;
+        old_defi_root_ = world_state.defi_tree.root();
+        old_defi_path_ = world_state.defi_tree.get_hash_path(first_defi_note_index);
+
+        // The results of the last block's interactions, which its deposits are claimed against.
+        interaction_notes_ = next_interaction_notes_;
+        next_interaction_notes_.clear();
+        for (size_t i = 0; i < interaction_notes_.size(); ++i) {
+            interaction_notes_[i].interaction_nonce =
+                static_cast<uint32_t>((rollup_id_ - 1) * NUM_BRIDGE_CALLS_PER_BLOCK + i);
+        }
+        world_state.add_defi_notes(interaction_notes_, first_defi_note_index);
+        context_.defi_interactions.resize(first_defi_note_index + interaction_notes_.size());
+        std::copy(interaction_notes_.begin(),
+                  interaction_notes_.end(),
+                  context_.defi_interactions.begin() + first_defi_note_index);
+
+        block_bridges_.clear();
+        bridge_totals_.clear();
+        block_notes_.clear();
+        block_deposits_.clear();
+    }
+
+    // Adds a tx, or a chain of at most `max_txs` txs, to the rollup being built.
+    void add_txs(std::vector<std::vector<uint8_t>>& txs, size_t max_txs)
+    {
+        switch (claims_.empty() ? kinds_(engine_) : kinds_with_claims_(engine_)) {
+        case SEND:
+            if (max_txs > 1 && std::bernoulli_distribution(mix_.chain_ratio)(engine_)) {
+                // The number of txs past the second is geometrically distributed.
+                auto p = 1.0 / std::max(mix_.mean_chain_length - 1, 1.0);
+                auto length = 2 + std::geometric_distribution<size_t>(p)(engine_);
+                add_chain(txs, std::min(length, max_txs));
+            } else {
+                add_transfer(txs, false);
+            }
+            return;
+        case WITHDRAW:
+            add_transfer(txs, true);
+            return;
+        case DEFI_DEPOSIT:
+            add_defi_deposit(txs);
+            return;
+        case ACCOUNT:
+            add_account(txs);
+            return;
+        case CLAIM:
+            add_claim(txs);
+            return;
+        default:
+            add_deposit(txs);
+        }
+    }
+
+    join_split::join_split_tx create_deposit_tx()
+    {
+        auto asset_id = uniform(0, mix_.num_asset_ids - 1);
+        std::array<uint32_t, 2> out = { uniform(1, mix_.max_note_value), uniform(0, mix_.max_note_value) };
+        auto public_input = uint256_t(out[0]) + out[1] + uniform(0, mix_.max_fee);
+        return context_.js_tx_factory.create_join_split_tx({}, {}, out, public_input, 0, 0, asset_id);
+    }
+
+    void add_deposit(std::vector<std::vector<uint8_t>>& txs)
+    {
+        auto tx = create_deposit_tx();
+        add_join_split(txs, tx);
+        counts_.deposits++;
+    }
+
+    // A send or withdrawal of one or two notes of one asset. A deposit if the user has no notes.
+    void add_transfer(std::vector<std::vector<uint8_t>>& txs, bool withdraw)
+    {
+        auto in = take_notes(std::nullopt);
+        if (in.empty()) {
+            add_deposit(txs);
+            return;
+        }
+        auto [in_idx, in_value, total] = to_inputs(in);
+        auto fee = uniform(0, std::min(mix_.max_fee, total - 1));
+        auto value = total - fee;
+        uint32_t public_output = withdraw ? uniform(1, value) : 0;
+        auto out0 = uniform(0, value - public_output);
+        auto tx = context_.js_tx_factory.create_join_split_tx(
+            in_idx, in_value, { out0, value - public_output - out0 }, 0, public_output, 0, in[0].asset_id);
+        add_join_split(txs, tx);
+        (withdraw ? counts_.withdraws : counts_.sends)++;
+    }
+
+    /**
+     * A chain of sends, each spending the first output note of the one before, so they must be in the same rollup.
+     * Starts with a send of the user's notes, or a deposit if they have none.
+     */
+    void add_chain(std::vector<std::vector<uint8_t>>& txs, size_t length)
+    {
+        auto in = take_notes(std::nullopt);
+        join_split::join_split_tx tx;
+        if (in.empty()) {
+            tx = create_deposit_tx();
+            counts_.deposits++;
+        } else {
+            auto [in_idx, in_value, total] = to_inputs(in);
+            auto value = total - uniform(0, std::min(mix_.max_fee, total - 1));
+            auto out0 = uniform(1, value);
+            tx = context_.js_tx_factory.create_join_split_tx(in_idx, in_value, { out0, value - out0 }, 0, 0, 0,
+                                                             in[0].asset_id);
+            counts_.sends++;
+        }
+
+        for (size_t i = 1; i < length && tx.output_note[0].value > 0; ++i) {
+            tx.allow_chain = 1;
+            add_join_split(txs, tx, true);
+
+            auto const& prev = tx.output_note[0];
+            auto value = static_cast<uint32_t>(prev.value);
+            auto fee = uniform(0, std::min(mix_.max_fee, value - 1));
+            // The first input is the propagated note, so its index is never used.
+            auto next = context_.js_tx_factory.create_join_split_tx(
+                { 0 }, { value }, { value - fee, 0 }, 0, 0, 0, prev.asset_id);
+            next.input_note[0] = prev;
+            next.backward_link = next.input_note[0].commit();
+            tx = next;
+            counts_.sends++;
+            counts_.chained++;
+        }
+        add_join_split(txs, tx);
+    }
+
+    void add_defi_deposit(std::vector<std::vector<uint8_t>>& txs)
+    {
+        if (bridges_.empty()) {
+            add_deposit(txs);
+            return;
+        }
+        auto bridge = uniform(0, static_cast<uint32_t>(bridges_.size() - 1));
+        // Bridges are spread over the assets as they're created.
+        auto in = take_notes(bridge % mix_.num_asset_ids);
+        if (in.empty()) {
+            add_deposit(txs);
+            return;
+        }
+        auto [in_idx, in_value, total] = to_inputs(in);
+        auto fee = uniform(0, std::min(mix_.max_fee, total - 1));
+        auto deposit = uniform(1, total - fee);
+        auto tx = context_.js_tx_factory.create_defi_deposit_tx(
+            in_idx, in_value, { deposit, total - fee - deposit }, bridges_[bridge], in[0].asset_id);
+
+        auto slot = std::find(block_bridges_.begin(), block_bridges_.end(), bridges_[bridge]) - block_bridges_.begin();
+        if (slot == static_cast<ptrdiff_t>(block_bridges_.size())) {
+            block_bridges_.push_back(bridges_[bridge]);
+            bridge_totals_.push_back(0);
+        }
+        bridge_totals_[static_cast<size_t>(slot)] += deposit;
+        // The rollup takes half of the fee, rounded down, and leaves the rest for the claim.
+        block_deposits_.push_back(
+            { block_rollup_, offset(txs), static_cast<uint32_t>(slot), deposit, fee - (fee >> 1) });
+        add_join_split(txs, tx);
+        counts_.defi_deposits++;
+    }
+
+    void add_claim(std::vector<std::vector<uint8_t>>& txs)
+    {
+        auto c = claims_.front();
+        claims_.pop_front();
+        auto tx = context_.create_claim_tx(
+            c.bridge_call_data, c.deposit_value, c.claim_note_index, c.defi_note_index, c.fee);
+        txs.push_back(claim_prover_.prove(tx));
+        counts_.claims++;
+    }
+
+    // Adds signing keys to the user's account, which, unlike creating or migrating it, can be done any number of times.
+    void add_account(std::vector<std::vector<uint8_t>>& txs)
+    {
+        grumpkin::g1::affine_element new_signing_keys[2] = { context_.extra_key_pairs[0].public_key,
+                                                             context_.extra_key_pairs[1].public_key };
+        auto tx = context_.account_tx_factory.create_add_signing_keys_to_account_tx(new_signing_keys,
+                                                                                    account_note_index_);
+        tx.sign(context_.user.signing_keys[0]);
+        txs.push_back(account_prover_.prove(tx));
+        counts_.accounts++;
+    }
+
+    // Signs and proves the tx, and records its output notes to be spent in later blocks, but for a chained one.
+    void add_join_split(std::vector<std::vector<uint8_t>>& txs, join_split::join_split_tx& tx, bool chained = false)
+    {
+        context_.js_tx_factory.finalise_and_sign_tx(tx, context_.user.owner);
+        for (size_t i = chained ? 1 : 0; i < 2; ++i) {
+            auto const& note = tx.output_note[i];
+            if (note.value > 0) {
+                block_notes_.push_back({ block_rollup_,
+                                         offset(txs) + static_cast<uint32_t>(i),
+                                         static_cast<uint32_t>(note.value),
+                                         note.asset_id });
+            }
+        }
+        txs.push_back(js_prover_.prove(tx));
+    }
+
+    // The offset into its rollup's data of the first output note of the next tx.
+    static uint32_t offset(std::vector<std::vector<uint8_t>> const& txs)
+    {
+        return static_cast<uint32_t>(txs.size() * 2);
+    }
+
+    // Takes one or two of the user's notes of one asset, `asset_id` if given, or none if there are none.
+    std::vector<note> take_notes(std::optional<uint32_t> asset_id)
+    {
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < notes_.size(); ++i) {
+            if (!asset_id || notes_[i].asset_id == *asset_id) {
+                candidates.push_back(i);
+            }
+        }
+        if (candidates.empty()) {
+            return {};
+        }
+        auto first = candidates[uniform(0, static_cast<uint32_t>(candidates.size() - 1))];
+        std::vector<size_t> taken = { first };
+        if (std::bernoulli_distribution(mix_.two_input_ratio)(engine_)) {
+            for (auto i : candidates) {
+                if (i != first && notes_[i].asset_id == notes_[first].asset_id) {
+                    taken.push_back(i);
+                    break;
+                }
+            }
+        }
+
+        std::vector<note> result;
+        std::sort(taken.rbegin(), taken.rend());
+        for (auto i : taken) {
+            result.push_back(notes_[i]);
+            notes_[i] = notes_.back();
+            notes_.pop_back();
+        }
+        return result;
+    }
+
+    static std::tuple<std::vector<uint32_t>, std::vector<uint32_t>, uint32_t> to_inputs(std::vector<note> const& in)
+    {
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> values;
+        uint32_t total = 0;
+        for (auto const& n : in) {
+            indices.push_back(n.index);
+            values.push_back(n.value);
+            total += n.value;
+        }
+        return { indices, values, total };
+    }
+
+    uint32_t uniform(uint32_t min, uint32_t max)
+    {
+        return std::uniform_int_distribution<uint32_t>(min, std::max(min, max))(engine_);
+    }
+
+    TestContext& context_;
+    tx_mix mix_;
+    std::mt19937_64 engine_;
+    std::discrete_distribution<int> kinds_;
+    // As `kinds_`, and claims, for while there are claimable defi deposits.
+    std::discrete_distribution<int> kinds_with_claims_;
+    proofs::prover_context<join_split::join_split_tx> js_prover_;
+    proofs::prover_context<account::account_tx> account_prover_;
+    proofs::prover_context<claim::claim_tx> claim_prover_;
+    tx_mix_counts counts_;
+
+    std::vector<uint256_t> asset_ids_;
+    std::vector<uint256_t> bridges_;
+    uint32_t account_note_index_ = 0;
+    // The user's notes that can be spent in this block.
+    std::vector<note> notes_;
+    std::vector<note> next_notes_;
+    std::deque<pending_claim> claims_;
+
+    bool in_block_ = false;
+    uint32_t rollup_id_ = 0;
+    size_t block_rollup_ = 0;
+    fr old_defi_root_;
+    fr_hash_path old_defi_path_;
+    std::vector<native::defi_interaction::note> interaction_notes_;
+    std::vector<native::defi_interaction::note> next_interaction_notes_;
+    std::vector<uint256_t> block_bridges_;
+    std::vector<uint256_t> bridge_totals_;
+    std::vector<block_note> block_notes_;
+    std::vector<block_deposit> block_deposits_;
+};
+
+} // namespace fixtures
+} // namespace rollup
@@ -3,62 +3,174 @@
 #include "../proofs/root_verifier/compute_circuit_data.hpp"
 #include "../proofs/rollup/rollup_tx.hpp"
 #include "../proofs/claim/index.hpp"
+#include "../proofs/mapped_reference_string_factory.hpp"
+#include "../constants.hpp"
 #include <common/timer.hpp>
 #include <plonk/composer/standard_composer.hpp>
 #include <plonk/proof_system/proving_key/proving_key.hpp>
 #include <plonk/proof_system/verification_key/verification_key.hpp>
 #include <plonk/proof_system/verification_key/sol_gen.hpp>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <unistd.h>
 
 using namespace ::rollup::proofs;
 namespace tx_rollup = ::rollup::proofs::rollup;
 
+namespace {
+// A root rollup's gates are dominated by the verification of each inner rollup proof. The reference count is of a root
+// rollup of 3 inner rollups.
+constexpr size_t ROOT_ROLLUP_GATES_PER_INNER_ROLLUP = ::rollup::circuit_gate_count::ROOT_ROLLUP / 3;
+// Rough peak memory of building a circuit and computing its proving key, per gate of the circuit's power of two size:
+// the composer's wires and selectors, and each selector and permutation polynomial in monomial and 4n coset form.
+constexpr size_t PEAK_BYTES_PER_GATE = 3 * 1024;
+
+size_t estimate_root_rollup_peak_bytes(size_t num_inner_rollups)
+{
+    size_t num_gates = num_inner_rollups * ROOT_ROLLUP_GATES_PER_INNER_ROLLUP;
+    return (size_t(1) << (numeric::get_msb(num_gates) + 1)) * PEAK_BYTES_PER_GATE;
+}
+
+/**
+ * Admits jobs while the sum of their memory estimates is within a cap. A job estimated above the cap on its own is
+ * admitted once nothing else is running.
+ */
+class memory_budget {
+  public:
+    explicit memory_budget(size_t cap)
+        : cap_(cap)
+    {}
+
+    void acquire(size_t bytes)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return in_use_ == 0 || in_use_ + bytes <= cap_; });
+        in_use_ += bytes;
+    }
+
+    void release(size_t bytes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            in_use_ -= bytes;
+        }
+        cv_.notify_all();
+    }
+
+  private:
+    size_t const cap_;
+    size_t in_use_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+} // namespace
+
 int main(int argc, char** argv)
 {
     std::vector<std::string> args(argv, argv + argc);
     if (args.size() < 4) {
-        info(
-            "usage: ", args[0], " <num inner txs> <comma separated valid outer sizes> <output path> <mock> [srs path]");
+        info("usage: ",
+             args[0],
+             " <comma separated inner sizes> <comma separated valid outer sizes> <output path> <mock> [srs path] "
+             "[max memory GiB] [data path]");
         return 1;
     }
-    size_t num_inner_tx = (size_t)atoi(args[1].c_str());
-    std::string outer_sizes_raw = args[2];
-    // parse list of valid outer sizes
-    std::vector<size_t> valid_outer_sizes;
-    std::istringstream is(outer_sizes_raw);
-    std::string outer_size;
-    while (std::getline(is, outer_size, ',')) {
-        valid_outer_sizes.emplace_back(std::stoul(outer_size));
+    // parse lists of valid inner and outer sizes
+    auto parse_sizes = [](std::string const& sizes_raw) {
+        std::vector<size_t> sizes;
+        std::istringstream is(sizes_raw);
+        std::string size;
+        while (std::getline(is, size, ',')) {
+            sizes.emplace_back(std::stoul(size));
+        }
+        return sizes;
     };
+    std::string inner_sizes_raw = args[1];
+    std::string outer_sizes_raw = args[2];
+    auto valid_inner_sizes = parse_sizes(inner_sizes_raw);
+    auto valid_outer_sizes = parse_sizes(outer_sizes_raw);
 
     const std::string output_path = args[3];
     const bool mock_proof = (args.size() > 4) ? args[4] == "true" : false;
     const std::string srs_path = (args.size() > 5) ? args[5] : "../barretenberg/cpp/srs_db/ignition";
+    // Root rollups of different outer sizes are built in parallel, as far as their estimated memory fits under this.
+    // Defaults to the machine's physical memory.
+    const size_t max_memory = (args.size() > 6) ? std::stoul(args[6]) << 30
+                                                : (size_t)sysconf(_SC_PHYS_PAGES) * (size_t)sysconf(_SC_PAGE_SIZE);
+    // Where the account, join split and claim circuits' keys, and the srs point table, are persisted, as rollup_cli
+    // does.
+    const std::string data_path = (args.size() > 7) ? args[7] : "./data";
 
-    auto srs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(srs_path);
+    auto srs = std::make_shared<mapped_reference_string_factory>(srs_path, data_path);
 
     if (!mock_proof) {
-        auto account_cd = account::get_circuit_data(srs);
-        auto join_split_cd = join_split::get_circuit_data(srs);
-        auto claim_cd = claim::get_circuit_data(srs);
-        auto rollup_cd = tx_rollup::get_circuit_data(
-            num_inner_tx, join_split_cd, account_cd, claim_cd, srs, "", true, false, false, true, true);
+        auto account_cd = account::get_circuit_data(srs, false, data_path, true, true, true);
+        auto join_split_cd = join_split::get_circuit_data(srs, false, data_path, true, true, true);
+        auto claim_cd = claim::get_circuit_data(srs, false, data_path, true, true, true);
+        // The root verifier accepts proofs from the root rollups of every inner and outer size, as rollup_cli's does.
+        auto root_rollup_sizes = root_verifier::get_valid_root_rollup_sizes(valid_inner_sizes, valid_outer_sizes);
+        std::map<size_t, tx_rollup::circuit_data> rollup_cds;
+        for (auto const& size : root_rollup_sizes) {
+            auto num_inner_tx = size.first;
+            if (!rollup_cds.count(num_inner_tx)) {
+                rollup_cds[num_inner_tx] = tx_rollup::get_circuit_data(
+                    num_inner_tx, join_split_cd, account_cd, claim_cd, srs, "", true, false, false, true, true);
+                // Release memory held by proving key, we don't need it.
+                rollup_cds[num_inner_tx].proving_key.reset();
+            }
+        }
+
+        // Only the verification keys of the root rollups are needed, bar one padding proof to build the root verifier
+        // with. Root rollups of any size have the same public inputs, so the root verifier circuit is the same
+        // whichever it is built with, and the padding proof is taken from the smallest.
+        auto padding_size = root_rollup_sizes.front();
+        std::vector<root_rollup::circuit_data> root_rollup_cds(root_rollup_sizes.size());
+        std::vector<size_t> order(root_rollup_sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return root_rollup_sizes[a].second > root_rollup_sizes[b].second;
+        });
 
-        // Release memory held by proving key, we don't need it.
-        rollup_cd.proving_key.reset();
+        Timer timer;
+        memory_budget budget(max_memory);
+        std::vector<std::future<void>> jobs;
+        for (auto i : order) {
+            jobs.push_back(std::async(std::launch::async, [&, i] {
+                auto [num_inner_tx, outer_size] = root_rollup_sizes[i];
+                auto pk = root_rollup_sizes[i] == padding_size;
+                auto peak_bytes = estimate_root_rollup_peak_bytes(outer_size);
+                budget.acquire(peak_bytes);
+                try {
+                    root_rollup_cds[i] = root_rollup::get_circuit_data(
+                        outer_size, rollup_cds.at(num_inner_tx), srs, "", true, false, false, pk, true);
+                } catch (...) {
+                    budget.release(peak_bytes);
+                    throw;
+                }
+                root_rollup_cds[i].proving_key.reset();
+                budget.release(peak_bytes);
+            }));
+        }
+        for (auto& job : jobs) {
+            job.get();
+        }
+        info("Root rollup verification keys computed in ", timer.toString(), "s");
 
         std::vector<std::shared_ptr<waffle::verification_key>> valid_root_rollup_vks;
-        root_rollup::circuit_data root_rollup_cd;
-        root_verifier::circuit_data root_verifier_cd;
-        for (auto i : valid_outer_sizes) {
-            root_rollup_cd.proving_key.reset();
-            root_rollup_cd = root_rollup::get_circuit_data(i, rollup_cd, srs, "", true, false, false, true, true);
+        for (auto const& root_rollup_cd : root_rollup_cds) {
             valid_root_rollup_vks.emplace_back(root_rollup_cd.verification_key);
         }
+        auto const& root_rollup_cd = root_rollup_cds.front();
 
-        root_verifier_cd = root_verifier::get_circuit_data(
-            root_rollup_cd, srs, valid_root_rollup_vks, "", true, false, false, true, true);
-        std::replace(outer_size.begin(), outer_size.end(), ',', '_');
-        auto class_name = format(mock_proof ? "Mock" : "", "VerificationKey", num_inner_tx, "x", outer_size);
+        auto root_verifier_cd = root_verifier::get_circuit_data(
+            root_rollup_cd, srs, valid_root_rollup_vks, "", true, false, false, false, true);
+        std::replace(inner_sizes_raw.begin(), inner_sizes_raw.end(), ',', '_');
+        std::replace(outer_sizes_raw.begin(), outer_sizes_raw.end(), ',', '_');
+        auto class_name =
+            format(mock_proof ? "Mock" : "", "VerificationKey", inner_sizes_raw, "x", outer_sizes_raw);
         auto filename = output_path + "/" + class_name + ".sol";
         std::ofstream os(filename);
         output_vk_sol(os, root_verifier_cd.verification_key, class_name);
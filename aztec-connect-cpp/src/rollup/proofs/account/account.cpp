@@ -3,8 +3,8 @@
 #include "../mock/mock_circuit.hpp"
 #include "../notes/constants.hpp"
 #include "../add_zero_public_inputs.hpp"
+#include "../circuit_types.hpp"
 #include <common/log.hpp>
-#include <plonk/composer/turbo/compute_verification_key.hpp>
 #include <stdlib/primitives/field/pow.hpp>
 #include <stdlib/merkle_tree/membership.hpp>
 #include <plonk/proof_system/commitment_scheme/kate_commitment_scheme.hpp>
@@ -18,7 +18,7 @@ namespace proofs {
 namespace account {
 
 using namespace plonk;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace notes::circuit::account;
 
 static std::shared_ptr<waffle::proving_key> proving_key;
@@ -218,7 +218,7 @@ void init_verification_key(std::shared_ptr<waffle::ReferenceStringFactory> const
         // Patch the 'nothing' reference string fed to init_proving_key.
         proving_key->reference_string = crs_factory->get_prover_crs(proving_key->n + 1);
     }
-    verification_key = waffle::turbo_composer::compute_verification_key(proving_key, crs_factory->get_verifier_crs());
+    verification_key = circuit_types::compute_verification_key(proving_key, crs_factory->get_verifier_crs());
 }
 
 void init_verification_key(std::shared_ptr<waffle::VerifierMemReferenceString> const& crs,
@@ -255,8 +255,8 @@ bool verify_proof(waffle::plonk_proof const& proof)
     UnrolledVerifier verifier(verification_key,
                               Composer::create_unrolled_manifest(verification_key->num_public_inputs));
 
-    std::unique_ptr<waffle::KateCommitmentScheme<waffle::unrolled_turbo_settings>> kate_commitment_scheme =
-        std::make_unique<waffle::KateCommitmentScheme<waffle::unrolled_turbo_settings>>();
+    std::unique_ptr<waffle::KateCommitmentScheme<circuit_types::unrolled_program_settings>> kate_commitment_scheme =
+        std::make_unique<waffle::KateCommitmentScheme<circuit_types::unrolled_program_settings>>();
     verifier.commitment_scheme = std::move(kate_commitment_scheme);
 
     return verifier.verify_proof(proof);
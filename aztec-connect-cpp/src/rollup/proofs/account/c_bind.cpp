@@ -2,6 +2,9 @@
 #include "account.hpp"
 #include "compute_signing_data.hpp"
 #include "../mock/mock_circuit.hpp"
+#include "../circuit_types.hpp"
+#include "../proving_key_stream.hpp"
+#include "../prover_context.hpp"
 #include <common/streams.hpp>
 #include <common/container.hpp>
 #include <cstdint>
@@ -11,7 +14,7 @@
 #include <sstream>
 
 using namespace barretenberg;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace rollup::proofs::account;
 
 #define WASM_EXPORT __attribute__((visibility("default")))
@@ -39,13 +42,15 @@ WASM_EXPORT void account__init_proving_key_from_buffer(uint8_t const* pk_buf)
     init_proving_key(crs, std::move(pk_data));
 }
 
+WASM_EXPORT uint32_t account__get_proving_key_size()
+{
+    return static_cast<uint32_t>(rollup::proofs::serialized_proving_key_size(*get_proving_key()));
+}
+
 WASM_EXPORT uint32_t account__get_new_proving_key_data(uint8_t** output)
 {
-    // Computing the size of the serialized key is non trivial.
-    // Allocate a buffer large enough to hold it, and abort if we overflow.
-    // This is to keep memory usage down.
-    size_t total_buf_len = 350 * 1024 * 1024;
-    auto raw_buf = (uint8_t*)malloc(total_buf_len);
+    auto len = account__get_proving_key_size();
+    auto raw_buf = (uint8_t*)malloc(len);
     if (!raw_buf) {
         info("Failed to alloc.");
         std::abort();
@@ -53,14 +58,34 @@ WASM_EXPORT uint32_t account__get_new_proving_key_data(uint8_t** output)
     auto raw_buf_end = raw_buf;
     write(raw_buf_end, *get_proving_key());
     *output = raw_buf;
-    auto len = static_cast<uint32_t>(raw_buf_end - raw_buf);
-    if (len > total_buf_len) {
-        info("Buffer overflow serializing proving key.");
-        std::abort();
-    }
     return len;
 }
 
+WASM_EXPORT void account__write_proving_key_chunks(rollup::proofs::proving_key_chunk_callback callback, void* ctx)
+{
+    rollup::proofs::write_proving_key_chunks(*get_proving_key(), callback, ctx);
+}
+
+WASM_EXPORT void* account__new_proving_key_reader()
+{
+    return new rollup::proofs::proving_key_reader();
+}
+
+WASM_EXPORT void account__proving_key_reader_add_chunk(void* reader, uint8_t const* chunk, uint32_t length)
+{
+    reinterpret_cast<rollup::proofs::proving_key_reader*>(reader)->add_chunk(chunk, length);
+}
+
+WASM_EXPORT void account__init_proving_key_from_reader(void* reader)
+{
+    auto key_reader = std::unique_ptr<rollup::proofs::proving_key_reader>(
+        reinterpret_cast<rollup::proofs::proving_key_reader*>(reader));
+    std::shared_ptr<waffle::ProverReferenceString> crs;
+    // Free the current key first, so only the new one is held as it's read.
+    release_key();
+    init_proving_key(crs, key_reader->read_key());
+}
+
 WASM_EXPORT void account__init_verification_key(void* pippenger, uint8_t const* g2x)
 {
     auto crs_factory = std::make_unique<waffle::PippengerReferenceStringFactory>(
@@ -105,6 +130,26 @@ WASM_EXPORT void account__delete_prover(void* prover)
     delete reinterpret_cast<Prover*>(prover);
 }
 
+WASM_EXPORT void* account__new_prover_context(bool mock)
+{
+    return new rollup::proofs::prover_context<account_tx>(get_proving_key(), account_circuit, mock);
+}
+
+WASM_EXPORT uint32_t account__prover_context_prove(void* context, uint8_t const* account_buf, uint8_t** output)
+{
+    auto tx = from_buffer<account_tx>(account_buf);
+    auto proof = reinterpret_cast<rollup::proofs::prover_context<account_tx>*>(context)->prove(tx);
+    auto raw_buf = (uint8_t*)malloc(proof.size());
+    memcpy(raw_buf, proof.data(), proof.size());
+    *output = raw_buf;
+    return static_cast<uint32_t>(proof.size());
+}
+
+WASM_EXPORT void account__delete_prover_context(void* context)
+{
+    delete reinterpret_cast<rollup::proofs::prover_context<account_tx>*>(context);
+}
+
 WASM_EXPORT bool account__verify_proof(uint8_t* proof, uint32_t length)
 {
     waffle::plonk_proof pp = { std::vector<uint8_t>(proof, proof + length) };
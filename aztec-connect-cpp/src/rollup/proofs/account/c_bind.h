@@ -8,8 +8,25 @@ WASM_EXPORT void account__init_proving_key(bool mock);
 
 WASM_EXPORT void account__init_proving_key_from_buffer(uint8_t const* pk_buf);
 
+// Exact size of the serialized proving key, computed without serializing it into memory.
+WASM_EXPORT uint32_t account__get_proving_key_size();
+
 WASM_EXPORT uint32_t account__get_new_proving_key_data(uint8_t** output);
 
+// Serializes the proving key through `callback` a chunk at a time, rather than into one buffer.
+WASM_EXPORT void account__write_proving_key_chunks(
+    void (*callback)(void* ctx, uint8_t const* chunk, uint32_t length), void* ctx);
+
+/**
+ * Imports a serialized proving key a chunk at a time: create a reader, add the chunks in order, then init from it.
+ * Chunks are freed as they're read, so peak memory is about one key. Init takes ownership of the reader.
+ */
+WASM_EXPORT void* account__new_proving_key_reader();
+
+WASM_EXPORT void account__proving_key_reader_add_chunk(void* reader, uint8_t const* chunk, uint32_t length);
+
+WASM_EXPORT void account__init_proving_key_from_reader(void* reader);
+
 WASM_EXPORT void account__init_verification_key(void* pippenger, uint8_t const* g2x);
 
 WASM_EXPORT void account__init_verification_key_from_buffer(uint8_t const* vk_buf, uint8_t const* g2x);
@@ -22,5 +39,15 @@ WASM_EXPORT void* account__new_prover(uint8_t const* account_buf, bool mock);
 
 WASM_EXPORT void account__delete_prover(void* prover);
 
+/**
+ * Proves transactions back to back with the current proving key, building each circuit in the buffers of the last. Each
+ * proof is returned in a buffer allocated for the caller to free.
+ */
+WASM_EXPORT void* account__new_prover_context(bool mock);
+
+WASM_EXPORT uint32_t account__prover_context_prove(void* context, uint8_t const* account_buf, uint8_t** output);
+
+WASM_EXPORT void account__delete_prover_context(void* context);
+
 WASM_EXPORT bool account__verify_proof(uint8_t* proof, uint32_t length);
 }
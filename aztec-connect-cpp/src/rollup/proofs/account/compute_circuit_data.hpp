@@ -45,7 +45,15 @@ inline account_tx noop_tx()
 
 using circuit_data = proofs::circuit_data;
 
-inline circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs, bool mock = false)
+// Takes a key path to persist the circuit's keys under and load them from, as join_split::get_circuit_data does.
+inline circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs,
+                                     bool mock = false,
+                                     std::string const& key_path = "",
+                                     bool compute = true,
+                                     bool save = false,
+                                     bool load = false,
+                                     bool pk = true,
+                                     bool vk = true)
 {
     std::cerr << "Getting account circuit data..." << std::endl;
 
@@ -56,7 +64,7 @@ inline circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFact
     };
 
     return proofs::get_circuit_data<Composer>(
-        "account", "", srs, "", true, false, false, true, true, false, mock, build_circuit);
+        "account", "account", srs, key_path, compute, save, load, pk, vk, false, mock, build_circuit);
 }
 
 } // namespace account
@@ -2,13 +2,13 @@
 #include "../verify.hpp"
 #include "./compute_circuit_data.hpp"
 #include "./account.hpp"
-#include <stdlib/types/turbo.hpp>
+#include "../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace account {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 verify_result<Composer> verify_logic(account_tx& tx, circuit_data const& cd);
 
@@ -1,10 +1,10 @@
 #pragma once
-#include <stdlib/types/turbo.hpp>
+#include "circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 inline void add_zero_public_inputs(Composer& composer, size_t num)
 {
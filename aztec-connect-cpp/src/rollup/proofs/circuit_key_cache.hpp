@@ -0,0 +1,203 @@
+#pragma once
+#include <common/log.hpp>
+#include <common/throw_or_abort.hpp>
+#include <common/serialize.hpp>
+#include <crypto/sha256/sha256.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <plonk/proof_system/verification_key/verification_key.hpp>
+#include <sstream>
+
+namespace rollup {
+namespace proofs {
+
+// The first 8 bytes of a hash, in hex: enough to tell apart the entries of a circuit.
+inline std::string short_hex(sha256::hash const& hash)
+{
+    std::ostringstream os;
+    for (size_t i = 0; i < 8; ++i) {
+        os << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+    }
+    return os.str();
+}
+
+/**
+ * The address a circuit's keys are cached under, within its `path_name` directory: a hash of what they're built
+ * from besides the circuit's constraints. That is the circuit's name (which encodes its sizes and options), the
+ * composer, whether it's mocked, and the verification keys of the proofs it verifies.
+ */
+inline std::string circuit_key_hash(
+    std::string const& path_name,
+    std::string const& composer,
+    bool mock,
+    std::vector<std::shared_ptr<waffle::verification_key>> const& inner_verification_keys)
+{
+    using serialize::write;
+    std::vector<uint8_t> buf;
+    write(buf, path_name);
+    write(buf, composer);
+    write(buf, mock);
+    for (auto const& vk : inner_verification_keys) {
+        write(buf, vk ? to_buffer(*vk) : std::vector<uint8_t>());
+    }
+    return short_hex(sha256::sha256(buf));
+}
+
+/**
+ * A hash of a built circuit's constraints: its selectors, the variable each wire refers to once copy constraints
+ * are applied, and its public inputs. It changes with any change to the circuit, but not with the witness it was
+ * built over. Hashed 1MB at a time, chaining each block's hash into the next, as a rollup circuit's selectors run to
+ * gigabytes.
+ */
+template <typename Composer> inline std::string circuit_structure_hash(Composer const& composer)
+{
+    using serialize::write;
+    constexpr size_t BLOCK_SIZE = 1 << 20;
+    std::vector<uint8_t> buf;
+    auto flush = [&](bool force) {
+        if (buf.size() >= BLOCK_SIZE || force) {
+            auto hash = sha256::sha256(buf);
+            buf.assign(hash.begin(), hash.end());
+        }
+    };
+    for (auto const& selector : composer.selectors) {
+        for (auto const& value : selector) {
+            write(buf, value);
+            flush(false);
+        }
+    }
+    for (auto const* wire : { &composer.w_l, &composer.w_r, &composer.w_o, &composer.w_4 }) {
+        for (auto index : *wire) {
+            write(buf, composer.real_variable_index[index]);
+            flush(false);
+        }
+    }
+    for (auto index : composer.public_inputs) {
+        write(buf, composer.real_variable_index[index]);
+    }
+    write(buf, static_cast<uint64_t>(composer.get_num_gates()));
+    flush(true);
+    sha256::hash hash;
+    std::copy(buf.begin(), buf.end(), hash.begin());
+    return short_hex(hash);
+}
+
+/**
+ * The size and a sampled 64 bit hash of each file of a cache entry, recorded as they're written and checked before
+ * they're loaded, so a truncated or partly overwritten key is recomputed rather than used. Kept in a `checksums` file
+ * in the entry. This is a truncation check, not an integrity check: a multi gigabyte key is only sampled, so damage
+ * between the sampled blocks goes unnoticed.
+ */
+class key_checksums {
+  public:
+    explicit key_checksums(std::string const& dir)
+        : dir_(dir)
+        , path_(dir + "/checksums")
+    {
+        std::ifstream is(path_);
+        if (!is.good()) {
+            return;
+        }
+        using serialize::read;
+        uint32_t num_entries = 0;
+        read(is, num_entries);
+        for (uint32_t i = 0; i < num_entries && is.good(); ++i) {
+            std::string file;
+            std::pair<uint64_t, uint64_t> checksum;
+            read(is, file);
+            read(is, checksum.first);
+            read(is, checksum.second);
+            entries_[file] = checksum;
+        }
+    }
+
+    // Whether the file, or every file under the directory, at `path` has the recorded size and sampled hash.
+    bool matches(std::string const& path) const
+    {
+        if (!std::filesystem::exists(path)) {
+            return false;
+        }
+        for (auto const& file : files(path)) {
+            auto it = entries_.find(relative(file));
+            if (it == entries_.end() || it->second != checksum(file)) {
+                info("Checksum mismatch, discarding: ", file);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Records the file, or every file under the directory, at `path`.
+    void add(std::string const& path)
+    {
+        for (auto const& file : files(path)) {
+            entries_[relative(file)] = checksum(file);
+        }
+        std::ofstream os(path_);
+        using serialize::write;
+        write(os, static_cast<uint32_t>(entries_.size()));
+        for (auto const& [file, checksum] : entries_) {
+            write(os, file);
+            write(os, checksum.first);
+            write(os, checksum.second);
+        }
+        if (!os.good()) {
+            throw_or_abort(format("Failed to write: ", path_));
+        }
+    }
+
+    static std::pair<uint64_t, uint64_t> checksum(std::string const& path)
+    {
+        // FNV-1a over evenly spaced 64KB blocks, the first and last included, so checking a multi gigabyte proving
+        // key reads a few MB of it rather than all of it before it's loaded. Files of up to 4MB are hashed whole.
+        constexpr uint64_t FNV_PRIME = 0x100000001b3;
+        constexpr uint64_t BLOCK_SIZE = 1 << 16;
+        constexpr uint64_t NUM_SAMPLES = 64;
+        uint64_t hash = 0xcbf29ce484222325;
+        uint64_t size = std::filesystem::file_size(path);
+        uint64_t num_blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        uint64_t num_samples = std::min(num_blocks, NUM_SAMPLES);
+        std::ifstream is(path, std::ios::binary);
+        std::vector<char> block(BLOCK_SIZE);
+        for (uint64_t i = 0; i < num_samples; ++i) {
+            auto index = num_samples == 1 ? 0 : i * (num_blocks - 1) / (num_samples - 1);
+            is.clear();
+            is.seekg(static_cast<std::streamoff>(index * BLOCK_SIZE));
+            is.read(block.data(), static_cast<std::streamsize>(BLOCK_SIZE));
+            auto bytes = static_cast<size_t>(is.gcount());
+            for (size_t j = 0; j < bytes; ++j) {
+                hash = (hash ^ static_cast<uint8_t>(block[j])) * FNV_PRIME;
+            }
+        }
+        return { size, hash };
+    }
+
+  private:
+    std::vector<std::string> files(std::string const& path) const
+    {
+        if (!std::filesystem::is_directory(path)) {
+            return { path };
+        }
+        std::vector<std::string> result;
+        for (auto const& entry : std::filesystem::recursive_directory_iterator(path)) {
+            if (entry.is_regular_file()) {
+                result.push_back(entry.path().string());
+            }
+        }
+        return result;
+    }
+
+    std::string relative(std::string const& file) const
+    {
+        return std::filesystem::relative(file, dir_).string();
+    }
+
+    std::string dir_;
+    std::string path_;
+    std::map<std::string, std::pair<uint64_t, uint64_t>> entries_;
+};
+
+} // namespace proofs
+} // namespace rollup
@@ -0,0 +1,56 @@
+#pragma once
+#ifdef ROLLUP_PLOOKUP_CIRCUITS
+#include <stdlib/types/ultra.hpp>
+#include <plonk/composer/ultra/compute_verification_key.hpp>
+#else
+#include <stdlib/types/turbo.hpp>
+#include <plonk/composer/turbo/compute_verification_key.hpp>
+#endif
+#include <stdlib/recursion/verifier/program_settings.hpp>
+
+namespace rollup {
+namespace proofs {
+
+/**
+ * The composer and stdlib types the rollup circuits (join split, account, claim, tx rollup and root rollup) are built
+ * with, and the settings used to verify their proofs recursively.
+ *
+ * Turbo by default. Configuring with -DPLOOKUP_CIRCUITS=ON builds them all with barretenberg's plookup (ultra)
+ * composer instead, whose lookup tables make sha256, range constraints and bit decompositions far cheaper. The two
+ * produce different keys, so plookup builds are not accepted by the rollup contract, and are for measurement only.
+ * See the comparison suite in `root_rollup/composer_comparison_full.test.cpp`.
+ */
+namespace circuit_types {
+#ifdef ROLLUP_PLOOKUP_CIRCUITS
+// Whether this is the composer `circuit_gate_count` and `circuit_vk_hash` were recorded with, so regression tests can
+// compare against them.
+constexpr bool is_reference_composer = false;
+using namespace plonk::stdlib::types::ultra;
+using unrolled_program_settings = waffle::unrolled_ultra_settings;
+template <typename Curve>
+using recursive_inner_verifier_settings = plonk::stdlib::recursion::recursive_ultra_verifier_settings<Curve>;
+
+inline std::shared_ptr<waffle::verification_key> compute_verification_key(
+    std::shared_ptr<waffle::proving_key> const& proving_key,
+    std::shared_ptr<waffle::VerifierReferenceString> const& crs)
+{
+    return waffle::ultra_composer::compute_verification_key(proving_key, crs);
+}
+#else
+constexpr bool is_reference_composer = true;
+using namespace plonk::stdlib::types::turbo;
+using unrolled_program_settings = waffle::unrolled_turbo_settings;
+template <typename Curve>
+using recursive_inner_verifier_settings = plonk::stdlib::recursion::recursive_turbo_verifier_settings<Curve>;
+
+inline std::shared_ptr<waffle::verification_key> compute_verification_key(
+    std::shared_ptr<waffle::proving_key> const& proving_key,
+    std::shared_ptr<waffle::VerifierReferenceString> const& crs)
+{
+    return waffle::turbo_composer::compute_verification_key(proving_key, crs);
+}
+#endif
+} // namespace circuit_types
+
+} // namespace proofs
+} // namespace rollup
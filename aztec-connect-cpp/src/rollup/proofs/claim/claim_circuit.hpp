@@ -1,12 +1,12 @@
 #pragma once
 #include "claim_tx.hpp"
-#include <stdlib/types/turbo.hpp>
+#include "../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace claim {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 void claim_circuit(Composer& composer, claim_tx const& tx);
 
@@ -5,14 +5,14 @@
 #include "../notes/native/claim/compute_nullifier.hpp"
 #include "../notes/native/defi_interaction/note.hpp"
 #include "../notes/native/defi_interaction/compute_nullifier.hpp"
+#include "../circuit_types.hpp"
 #include <stdlib/merkle_tree/hash_path.hpp>
-#include <stdlib/types/turbo.hpp>
 
 namespace rollup {
 namespace proofs {
 namespace claim {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 struct claim_tx {
     fr data_root;
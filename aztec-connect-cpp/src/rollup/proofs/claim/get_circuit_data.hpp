@@ -15,7 +15,15 @@ using namespace plonk::stdlib::merkle_tree;
 
 using circuit_data = proofs::circuit_data;
 
-inline circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs, bool mock = false)
+// Takes a key path to persist the circuit's keys under and load them from, as join_split::get_circuit_data does.
+inline circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs,
+                                     bool mock = false,
+                                     std::string const& key_path = "",
+                                     bool compute = true,
+                                     bool save = false,
+                                     bool load = false,
+                                     bool pk = true,
+                                     bool vk = true)
 {
     std::cerr << "Getting claim circuit data..." << std::endl;
 
@@ -27,7 +35,7 @@ inline circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFact
     };
 
     return proofs::get_circuit_data<Composer>(
-        "claim", "", srs, "", true, false, false, true, true, false, mock, build_circuit);
+        "claim", "claim", srs, key_path, compute, save, load, pk, vk, false, mock, build_circuit);
 }
 
 } // namespace claim
@@ -1,13 +1,13 @@
 #pragma once
 #include "../verify.hpp"
 #include "./get_circuit_data.hpp"
-#include <stdlib/types/turbo.hpp>
+#include "../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace claim {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 verify_result<Composer> verify_logic(claim_tx& tx, circuit_data const& cd);
 
@@ -1,6 +1,8 @@
 #pragma once
 #include "join_split/join_split.hpp"
 #include "mock/mock_circuit.hpp"
+#include "gate_profiler.hpp"
+#include "circuit_key_cache.hpp"
 #include "../constants.hpp"
 #include <fstream>
 #include <sys/stat.h>
@@ -8,14 +10,86 @@
 #include <plonk/proof_system/proving_key/serialize.hpp>
 #include <filesystem>
 
+#ifdef ROLLUP_PLOOKUP_CIRCUITS
+#define GET_COMPOSER_NAME_STRING(composer)                                                                             \
+    (typeid(composer) == typeid(waffle::StandardComposer)                                                              \
+         ? "StandardPlonk"                                                                                             \
+         : typeid(composer) == typeid(waffle::UltraComposer) ? "UltraPlonk" : "NULLPlonk")
+#else
 #define GET_COMPOSER_NAME_STRING(composer)                                                                             \
     (typeid(composer) == typeid(waffle::StandardComposer)                                                              \
          ? "StandardPlonk"                                                                                             \
          : typeid(composer) == typeid(waffle::TurboComposer) ? "TurboPlonk" : "NULLPlonk")
+#endif
 
 namespace rollup {
 namespace proofs {
 
+/**
+ * The size of a circuit's witness, taken from the build `get_circuit_data` makes of it, so later jobs of the circuit
+ * can reserve their composer's variable storage up front (see `reserve_witness_capacity`). Only a hint, so it is kept
+ * in memory and never saved: circuit data loaded without building the circuit has none.
+ */
+struct circuit_shape {
+    uint64_t num_variables = 0;
+
+    bool operator==(circuit_shape const& other) const = default;
+};
+
+template <typename Composer> inline circuit_shape get_circuit_shape(Composer const& composer)
+{
+    return { composer.get_num_variables() };
+}
+
+/**
+ * What other circuits and services need of a circuit, short of its proving key: its verification key and padding
+ * proof. Saved next to the circuit's keys, and self describing so it can be checked against the circuit it's loaded
+ * for. A node can bring up the circuits that depend on this one from it, without building this circuit or holding
+ * its proving key.
+ */
+struct circuit_manifest {
+    static constexpr uint32_t VERSION = 3;
+
+    uint32_t version = VERSION;
+    std::string name;
+    std::string composer;
+    bool mock = false;
+    uint64_t num_gates = 0;
+    // A serialized waffle::verification_key, and the hash of the key it was serialized from.
+    std::vector<uint8_t> verification_key;
+    sha256::hash verification_key_hash = {};
+    std::vector<uint8_t> padding_proof;
+};
+
+template <typename B> inline void read(B& buf, circuit_manifest& manifest)
+{
+    using serialize::read;
+    read(buf, manifest.version);
+    if (manifest.version != circuit_manifest::VERSION) {
+        return;
+    }
+    read(buf, manifest.name);
+    read(buf, manifest.composer);
+    read(buf, manifest.mock);
+    read(buf, manifest.num_gates);
+    read(buf, manifest.verification_key);
+    read(buf, manifest.verification_key_hash);
+    read(buf, manifest.padding_proof);
+}
+
+template <typename B> inline void write(B& buf, circuit_manifest const& manifest)
+{
+    using serialize::write;
+    write(buf, manifest.version);
+    write(buf, manifest.name);
+    write(buf, manifest.composer);
+    write(buf, manifest.mock);
+    write(buf, manifest.num_gates);
+    write(buf, manifest.verification_key);
+    write(buf, manifest.verification_key_hash);
+    write(buf, manifest.padding_proof);
+}
+
 struct circuit_data {
     circuit_data()
         : num_gates(0)
@@ -27,8 +101,21 @@ struct circuit_data {
     size_t num_gates;
     std::vector<uint8_t> padding_proof;
     bool mock;
+    circuit_shape shape;
 };
 
+/**
+ * Reserves a job composer's variable storage for the witness size of the circuit's in memory build, as its size hint
+ * does for the gates. A no-op if `cd` was loaded without building the circuit. Only the allocation is saved: the
+ * circuit is still built gate by gate, as barretenberg's composers can't replay a recorded circuit with only new
+ * witness values.
+ */
+template <typename Composer> inline void reserve_witness_capacity(Composer& composer, circuit_data const& cd)
+{
+    composer.variables.reserve(cd.shape.num_variables);
+    composer.real_variable_index.reserve(cd.shape.num_variables);
+}
+
 namespace {
 inline bool exists(std::string const& path)
 {
@@ -37,6 +124,31 @@ inline bool exists(std::string const& path)
 }
 } // namespace
 
+/**
+ * Builds, loads and saves the keys and padding proof of the circuit `build_circuit` builds. When the circuit is built,
+ * its witness size is kept in the returned data's `shape`.
+ *
+ * With `vk` set and `pk` unset, only the verification key is produced: no proving key is loaded, kept or saved, and a
+ * missing saved proving key isn't recomputed. This is all keygen needs of most circuits. A padding proof needs a
+ * proving key, so is only computed when `pk` is set.
+ *
+ * Once a circuit has its verification key, and padding proof if `padding`, they are saved in its manifest. When no
+ * proving key is asked for, everything asked for is loaded from a manifest that describes this circuit, if there is
+ * one, and nothing is computed.
+ *
+ * Everything is saved under `key_path/path_name/<circuit_key_hash>/<circuit_structure_hash>`. The first changes with
+ * the circuit's build parameters and the verification keys of the proofs it verifies, `inner_vks`. The second is a
+ * hash of the constraints of the circuit as built, so when `compute` is set the circuit is always built, which takes
+ * a fraction of the time computing its keys does, and the keys of a changed circuit are never loaded.
+ *
+ * Without `compute`, the entry of the circuit last built with these parameters, as named by the `latest` file beside
+ * the entries, is loaded. Its constraints can't be checked against the current circuit without building it, so once
+ * a circuit has changed, callers that load its keys this way get the old keys until it is next built with `compute`.
+ * Nothing is loaded if it was never built, or its entry has gone.
+ *
+ * Each file's size and sampled checksum (see `key_checksums`) are recorded as it is saved, and it is only loaded if
+ * they still match. Anything missing, truncated or found damaged is recomputed.
+ */
 template <typename ComposerType, typename F>
 circuit_data get_circuit_data(std::string const& name,
                               std::string const& path_name,
@@ -50,7 +162,8 @@ circuit_data get_circuit_data(std::string const& name,
                               bool padding,
                               bool mock,
                               F const& build_circuit,
-                              std::string const name_suffix_for_benchmarks = "")
+                              std::string const name_suffix_for_benchmarks = "",
+                              std::vector<std::shared_ptr<waffle::verification_key>> const& inner_vks = {})
 {
     circuit_data data;
     data.srs = srs;
@@ -59,18 +172,23 @@ circuit_data get_circuit_data(std::string const& name,
     ComposerType mock_proof_composer(srs);
     BenchmarkInfoCollator benchmark_collator;
 
-    auto circuit_key_path = key_path + "/" + path_name;
-    auto pk_path = circuit_key_path + "/proving_key/proving_key";
-    auto vk_path = circuit_key_path + "/verification_key";
-    auto padding_path = circuit_key_path + "/padding_proof";
+    auto circuit_params_path = key_path + "/" + path_name + "/" +
+                               circuit_key_hash(path_name, GET_COMPOSER_NAME_STRING(ComposerType), mock, inner_vks);
+    // The structure hash of the circuit last built with these parameters, for callers that don't build it.
+    auto latest_path = circuit_params_path + "/latest";
+    std::string gate_profile;
+    std::string circuit_hash;
+    bool built = false;
 
-    // If we're missing required data, and compute is enabled, or if
-    // compute is enabled and load is disabled, build the circuit.
-    if (((!exists(pk_path) || !exists(vk_path) || (!exists(padding_path) && padding)) && compute) ||
-        (compute && !load)) {
+    // The circuit is built whenever anything may be computed, to find the entry of its current constraints.
+    if (compute) {
         info(name, ": Building circuit...");
         Timer timer;
+        gate_profiler profiler(name + name_suffix_for_benchmarks);
         build_circuit(composer);
+        built = true;
+        profiler.finish(composer.get_num_gates(), composer.variables.size());
+        gate_profile = profiler.folded();
 
         benchmark_collator.benchmark_info_deferred(GET_COMPOSER_NAME_STRING(ComposerType),
                                                    "Core",
@@ -84,6 +202,8 @@ circuit_data get_circuit_data(std::string const& name,
                                                    composer.get_num_gates());
         info(name, ": Circuit built in: ", timer.toString(), "s");
         info(name, ": Circuit size: ", composer.get_num_gates());
+        info(name, ": Gates by scope:\n", profiler.report());
+        data.shape = get_circuit_shape(composer);
         if (mock) {
             auto public_inputs = composer.get_public_inputs();
             mock::mock_circuit(mock_proof_composer, public_inputs);
@@ -94,17 +214,76 @@ circuit_data get_circuit_data(std::string const& name,
                                                        "Mock Gates",
                                                        composer.get_num_gates());
         }
+        circuit_hash = circuit_structure_hash(composer);
+        info(name, ": Circuit hash: ", circuit_hash);
+    } else {
+        std::ifstream is(latest_path);
+        std::getline(is, circuit_hash);
+        if (circuit_hash.empty() || !std::filesystem::exists(circuit_params_path + "/" + circuit_hash)) {
+            info(name, ": No keys saved under: ", circuit_params_path);
+            return data;
+        }
+        info(name, ": Loading keys of circuit ", circuit_hash, " as last built, not checked against the current one.");
+    }
+
+    auto circuit_key_path = circuit_params_path + "/" + circuit_hash;
+    auto pk_dir = circuit_key_path + "/proving_key";
+    auto pk_path = circuit_key_path + "/proving_key/proving_key";
+    auto vk_path = circuit_key_path + "/verification_key";
+    auto padding_path = circuit_key_path + "/padding_proof";
+    auto gate_profile_path = circuit_key_path + "/gate_profile.folded";
+    auto manifest_path = circuit_key_path + "/manifest";
+
+    // Each file is checked at most once.
+    key_checksums checksums(circuit_key_path);
+    std::map<std::string, bool> checked_files;
+    auto matches = [&](std::string const& path) {
+        auto it = checked_files.find(path);
+        return it != checked_files.end() ? it->second : (checked_files[path] = checksums.matches(path));
+    };
+
+    if (!pk && vk && load && matches(manifest_path)) {
+        circuit_manifest manifest;
+        std::ifstream is(manifest_path);
+        read(is, manifest);
+        if (manifest.version == circuit_manifest::VERSION && manifest.name == path_name &&
+            manifest.composer == GET_COMPOSER_NAME_STRING(ComposerType) && manifest.mock == mock &&
+            (!padding || !manifest.padding_proof.empty()) && is.good()) {
+            auto vk_data = from_buffer<waffle::verification_key_data>(manifest.verification_key);
+            auto verification_key =
+                std::make_shared<waffle::verification_key>(std::move(vk_data), srs->get_verifier_crs());
+            // The key must be the one the manifest was written for, and of a circuit that fits the recorded gates.
+            if (verification_key->sha256_hash() == manifest.verification_key_hash && manifest.num_gates > 0 &&
+                manifest.num_gates <= verification_key->n) {
+                info(name, ": Loading verification key and padding proof from: ", manifest_path);
+                data.verification_key = verification_key;
+                data.padding_proof = std::move(manifest.padding_proof);
+                data.num_gates = manifest.num_gates;
+                info(name, ": Verification key hash: ", data.verification_key->sha256_hash());
+                return data;
+            }
+        }
+        info(name, ": Manifest does not describe this circuit, ignoring: ", manifest_path);
     }
 
     // If we're saving data, create the circuit data directory.
     if (save) {
         std::filesystem::create_directories(key_path.c_str());
         std::filesystem::create_directories(circuit_key_path.c_str());
+        if (built) {
+            std::ofstream os(latest_path);
+            os << circuit_hash << std::endl;
+        }
+    }
+
+    // The gate profile is written in folded stacks format, for flamegraph.pl or speedscope.
+    if (!gate_profile.empty() && save) {
+        std::ofstream os(gate_profile_path);
+        os << gate_profile;
     }
 
     if (pk) {
-        auto pk_dir = circuit_key_path + "/proving_key";
-        if (exists(pk_path) && load) {
+        if (load && matches(pk_dir)) {
             info(name, ": Loading proving key: ", pk_path);
             auto pk_stream = std::ifstream(pk_path);
             waffle::proving_key_data pk_data;
@@ -159,13 +338,15 @@ circuit_data get_circuit_data(std::string const& name,
                 if (!os.good()) {
                     throw_or_abort(format("Failed to write: ", pk_path));
                 }
+                os.close();
+                checksums.add(pk_dir);
                 info(name, ": Saved in ", write_timer.toString(), "s");
             }
         }
     }
 
     if (vk) {
-        if (exists(vk_path) && load) {
+        if (load && matches(vk_path)) {
             info(name, ": Loading verification key from: ", vk_path);
             auto vk_stream = std::ifstream(vk_path);
             waffle::verification_key_data vk_data;
@@ -189,6 +370,14 @@ circuit_data get_circuit_data(std::string const& name,
             }
             info(name, ": Computed verification key in ", timer.toString(), "s");
 
+            // Verification key only: the composer commits to its selectors through a proving key of its own. Release
+            // it as soon as the commitments are taken, rather than holding it until the composer goes out of scope.
+            if (!pk) {
+                data.num_gates = mock ? mock_proof_composer.get_num_gates() : composer.get_num_gates();
+                composer.circuit_proving_key.reset();
+                mock_proof_composer.circuit_proving_key.reset();
+            }
+
             benchmark_collator.benchmark_info_deferred(GET_COMPOSER_NAME_STRING(ComposerType),
                                                        "Core",
                                                        name + name_suffix_for_benchmarks,
@@ -207,12 +396,14 @@ circuit_data get_circuit_data(std::string const& name,
                 if (!os.good()) {
                     throw_or_abort(format("Failed to write: ", vk_path));
                 }
+                os.close();
+                checksums.add(vk_path);
             }
         }
     }
 
     if (padding) {
-        if (exists(padding_path) && load) {
+        if (load && matches(padding_path)) {
             info(name, ": Loading padding proof from: ", padding_path);
             std::ifstream is(padding_path);
             std::vector<uint8_t> proof((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
@@ -256,10 +447,32 @@ circuit_data get_circuit_data(std::string const& name,
                 if (!os.good()) {
                     throw_or_abort(format("Failed to write: ", padding_path));
                 }
+                os.close();
+                checksums.add(padding_path);
             }
         }
     }
 
+    // Rewritten whenever the circuit is built, so it never describes an older circuit than the keys beside it.
+    bool complete = data.verification_key && (!padding || !data.padding_proof.empty());
+    if (save && complete && (built || !matches(manifest_path))) {
+        circuit_manifest manifest;
+        manifest.name = path_name;
+        manifest.composer = GET_COMPOSER_NAME_STRING(ComposerType);
+        manifest.mock = mock;
+        manifest.num_gates = data.num_gates;
+        manifest.verification_key = to_buffer(*data.verification_key);
+        manifest.verification_key_hash = data.verification_key->sha256_hash();
+        manifest.padding_proof = data.padding_proof;
+        std::ofstream os(manifest_path);
+        write(os, manifest);
+        if (!os.good()) {
+            throw_or_abort(format("Failed to write: ", manifest_path));
+        }
+        os.close();
+        checksums.add(manifest_path);
+    }
+
     return data;
 }
 
@@ -0,0 +1,193 @@
+#include "compute_circuit_data.hpp"
+#include "account/compute_circuit_data.hpp"
+#include "../constants.hpp"
+#include <common/test.hpp>
+#include <filesystem>
+
+namespace rollup {
+namespace proofs {
+
+using namespace ::rollup::proofs::circuit_types;
+
+/**
+ * Saves and loads the account circuit's keys, the smallest circuit, under a scratch key path. Counts how often the
+ * circuit is built, to tell what was loaded from what was computed. With `changed` set, the circuit built has an
+ * extra constraint.
+ */
+class compute_circuit_data_tests : public ::testing::Test {
+  protected:
+    compute_circuit_data_tests()
+        : srs(std::make_shared<waffle::DynamicFileReferenceStringFactory>("../barretenberg/cpp/srs_db/ignition"))
+        , key_path((std::filesystem::temp_directory_path() / "compute_circuit_data_test").string())
+    {
+        std::filesystem::remove_all(key_path);
+    }
+
+    ~compute_circuit_data_tests() { std::filesystem::remove_all(key_path); }
+
+    circuit_data get(bool compute,
+                     bool save,
+                     bool load,
+                     bool pk,
+                     std::vector<std::shared_ptr<waffle::verification_key>> const& inner_vks = {})
+    {
+        auto build_circuit = [&](Composer& composer) {
+            num_builds++;
+            account::account_tx tx(account::noop_tx());
+            tx.account_note_path.resize(DATA_TREE_DEPTH);
+            account::account_circuit(composer, tx);
+            if (changed) {
+                field_ct(witness_ct(&composer, 1)).create_range_constraint(8);
+            }
+        };
+        return get_circuit_data<Composer>("account",
+                                          "account",
+                                          srs,
+                                          key_path,
+                                          compute,
+                                          save,
+                                          load,
+                                          pk,
+                                          true,
+                                          true,
+                                          false,
+                                          build_circuit,
+                                          "",
+                                          inner_vks);
+    }
+
+    // The directory of the circuit's entries for the given inner verification keys.
+    std::string params_path(std::vector<std::shared_ptr<waffle::verification_key>> const& inner_vks = {}) const
+    {
+        auto hash = circuit_key_hash("account", GET_COMPOSER_NAME_STRING(Composer), false, inner_vks);
+        return key_path + "/account/" + hash;
+    }
+
+    // The entry of the circuit last built.
+    std::string entry_path(std::vector<std::shared_ptr<waffle::verification_key>> const& inner_vks = {}) const
+    {
+        std::ifstream is(params_path(inner_vks) + "/latest");
+        std::string circuit_hash;
+        std::getline(is, circuit_hash);
+        return params_path(inner_vks) + "/" + circuit_hash;
+    }
+
+    size_t num_entries(std::vector<std::shared_ptr<waffle::verification_key>> const& inner_vks = {}) const
+    {
+        size_t count = 0;
+        for (auto const& entry : std::filesystem::directory_iterator(params_path(inner_vks))) {
+            count += entry.is_directory();
+        }
+        return count;
+    }
+
+    std::shared_ptr<waffle::DynamicFileReferenceStringFactory> srs;
+    std::string key_path;
+    size_t num_builds = 0;
+    bool changed = false;
+};
+
+TEST_F(compute_circuit_data_tests, manifest_loads_without_building_circuit)
+{
+    auto saved = get(true, true, false, true);
+    EXPECT_EQ(num_builds, 1UL);
+
+    // No proving key is asked for, so the verification key and padding proof come from the manifest.
+    auto loaded = get(false, false, true, false);
+    EXPECT_EQ(num_builds, 1UL);
+    EXPECT_FALSE(loaded.proving_key);
+    EXPECT_EQ(loaded.verification_key->sha256_hash(), saved.verification_key->sha256_hash());
+    EXPECT_EQ(loaded.padding_proof, saved.padding_proof);
+    EXPECT_EQ(loaded.num_gates, saved.num_gates);
+    // The witness size is only known from a build, and is not saved.
+    EXPECT_GT(saved.shape.num_variables, 0UL);
+    EXPECT_EQ(loaded.shape.num_variables, 0UL);
+}
+
+TEST_F(compute_circuit_data_tests, manifest_with_inconsistent_key_is_ignored)
+{
+    auto saved = get(true, true, false, true);
+    EXPECT_EQ(num_builds, 1UL);
+
+    // Without the saved verification key, only the manifest can provide one without computing it.
+    std::filesystem::remove(entry_path() + "/verification_key");
+    EXPECT_TRUE(get(false, false, true, false).verification_key);
+
+    // Rewrites the manifest, and its checksum, so only the consistency of its contents can reject it.
+    auto manifest_path = entry_path() + "/manifest";
+    auto rewrite_manifest = [&](auto const& modify) {
+        circuit_manifest manifest;
+        {
+            std::ifstream is(manifest_path);
+            read(is, manifest);
+        }
+        modify(manifest);
+        {
+            std::ofstream os(manifest_path);
+            write(os, manifest);
+        }
+        key_checksums(entry_path()).add(manifest_path);
+    };
+
+    rewrite_manifest([&](circuit_manifest& manifest) { manifest.num_gates = saved.verification_key->n + 1; });
+    EXPECT_FALSE(get(false, false, true, false).verification_key);
+
+    rewrite_manifest([&](circuit_manifest& manifest) {
+        manifest.num_gates = saved.num_gates;
+        manifest.verification_key_hash[0] ^= 1;
+    });
+    EXPECT_FALSE(get(false, false, true, false).verification_key);
+    EXPECT_EQ(num_builds, 1UL);
+}
+
+TEST_F(compute_circuit_data_tests, damaged_and_changed_entries_are_recomputed)
+{
+    auto saved = get(true, true, true, true);
+    auto loaded = get(false, false, true, true);
+    EXPECT_EQ(num_builds, 1UL);
+    EXPECT_TRUE(loaded.proving_key);
+    EXPECT_EQ(loaded.verification_key->sha256_hash(), saved.verification_key->sha256_hash());
+
+    // A damaged verification key isn't loaded, and is recomputed the next time keys may be computed.
+    {
+        std::fstream fs(entry_path() + "/verification_key", std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(8);
+        fs.put('x');
+    }
+    EXPECT_FALSE(get(false, false, true, true).verification_key);
+    get(true, true, true, true);
+    EXPECT_EQ(get(false, false, true, true).verification_key->sha256_hash(), saved.verification_key->sha256_hash());
+
+    // A changed circuit gets an entry of its own. The unchanged circuit's entry is kept, and loaded once it's built
+    // again.
+    changed = true;
+    auto changed_cd = get(true, true, true, true);
+    EXPECT_NE(changed_cd.verification_key->sha256_hash(), saved.verification_key->sha256_hash());
+    EXPECT_EQ(num_entries(), 2UL);
+    changed = false;
+    get(true, true, true, true);
+    EXPECT_EQ(num_entries(), 2UL);
+    EXPECT_EQ(get(false, false, true, true).verification_key->sha256_hash(), saved.verification_key->sha256_hash());
+
+    // Keys built against other inner verification keys are cached separately, and both are kept.
+    get(true, true, true, true, { saved.verification_key });
+    EXPECT_EQ(num_entries({ saved.verification_key }), 1UL);
+    EXPECT_EQ(num_entries(), 2UL);
+}
+
+TEST_F(compute_circuit_data_tests, load_only_needs_the_latest_entry)
+{
+    // Nothing has been built, so there is no latest entry to load.
+    EXPECT_FALSE(get(false, false, true, false).verification_key);
+
+    get(true, true, false, true);
+    EXPECT_TRUE(get(false, false, true, false).verification_key);
+
+    // The latest entry has gone, and the entries left can't be told to be of the current circuit without building it.
+    std::filesystem::remove_all(entry_path());
+    EXPECT_FALSE(get(false, false, true, false).verification_key);
+    EXPECT_EQ(num_builds, 1UL);
+}
+
+} // namespace proofs
+} // namespace rollup
@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace rollup {
+namespace proofs {
+
+/**
+ * Attributes the gates and variables of a circuit to the code that added them.
+ *
+ * Circuit building code marks scopes with `gate_scope`. While a profiler is active on the building thread, each scope
+ * records the gates and variables its composer gained between its construction and its destruction. Scopes nest, and
+ * scopes of the same name under the same parent (e.g. one per tx) are merged into one node, counting the calls.
+ * With no active profiler a scope only reads a thread local, so scopes can be left in place.
+ *
+ * A profiler is active from its construction until its destruction. `get_circuit_data` profiles every circuit it
+ * builds.
+ */
+class gate_profiler {
+  public:
+    struct node {
+        std::string name;
+        size_t calls = 0;
+        // Inclusive of child scopes.
+        size_t gates = 0;
+        size_t variables = 0;
+        std::vector<std::unique_ptr<node>> children;
+    };
+
+    explicit gate_profiler(std::string const& name)
+        : previous_(active_)
+    {
+        root_.name = name;
+        root_.calls = 1;
+        stack_.push_back(&root_);
+        active_ = this;
+    }
+
+    ~gate_profiler() { active_ = previous_; }
+
+    gate_profiler(gate_profiler const&) = delete;
+    gate_profiler& operator=(gate_profiler const&) = delete;
+
+    static gate_profiler* active() { return active_; }
+
+    // Records the circuit's totals. Gates outside any scope are attributed to the root itself.
+    void finish(size_t num_gates, size_t num_variables)
+    {
+        root_.gates = num_gates;
+        root_.variables = num_variables;
+    }
+
+    node const& root() const { return root_; }
+
+    /**
+     * One line per scope, indented by depth, children in order of first entry:
+     *   <name> x<calls>: <gates> gates (<self gates> self), <variables> variables
+     */
+    std::string report() const
+    {
+        std::ostringstream os;
+        write_report(os, root_, 0);
+        return os.str();
+    }
+
+    /**
+     * Folded stacks, as read by flamegraph.pl and speedscope: one line per scope with its self gates.
+     *   <root>;<scope>;<child scope> <self gates>
+     */
+    std::string folded() const
+    {
+        std::ostringstream os;
+        write_folded(os, root_, "");
+        return os.str();
+    }
+
+  private:
+    template <typename Composer> friend class gate_scope;
+
+    node* enter(char const* name)
+    {
+        auto& children = stack_.back()->children;
+        auto it = std::find_if(children.begin(), children.end(), [&](auto const& c) { return c->name == name; });
+        node* n;
+        if (it == children.end()) {
+            children.push_back(std::make_unique<node>());
+            n = children.back().get();
+            n->name = name;
+        } else {
+            n = it->get();
+        }
+        stack_.push_back(n);
+        return n;
+    }
+
+    void exit(node* n, size_t gates, size_t variables)
+    {
+        n->calls++;
+        n->gates += gates;
+        n->variables += variables;
+        stack_.pop_back();
+    }
+
+    static size_t self_gates(node const& n)
+    {
+        size_t children_gates = 0;
+        for (auto const& c : n.children) {
+            children_gates += c->gates;
+        }
+        return n.gates - std::min(children_gates, n.gates);
+    }
+
+    static void write_report(std::ostream& os, node const& n, size_t depth)
+    {
+        os << std::string(depth * 2, ' ') << n.name << " x" << n.calls << ": " << n.gates << " gates ("
+           << self_gates(n) << " self), " << n.variables << " variables\n";
+        for (auto const& c : n.children) {
+            write_report(os, *c, depth + 1);
+        }
+    }
+
+    static void write_folded(std::ostream& os, node const& n, std::string const& prefix)
+    {
+        // Frames can't contain the separators.
+        auto frame = n.name;
+        std::replace(frame.begin(), frame.end(), ';', ',');
+        std::replace(frame.begin(), frame.end(), ' ', '_');
+        auto stack = prefix.empty() ? frame : prefix + ";" + frame;
+        os << stack << " " << self_gates(n) << "\n";
+        for (auto const& c : n.children) {
+            write_folded(os, *c, stack);
+        }
+    }
+
+    node root_;
+    std::vector<node*> stack_;
+    gate_profiler* previous_;
+    static inline thread_local gate_profiler* active_ = nullptr;
+};
+
+/**
+ * Attributes the gates and variables `composer` gains during this object's lifetime to a scope named `name`, in the
+ * profiler active on this thread (if any).
+ */
+template <typename Composer> class gate_scope {
+  public:
+    gate_scope(Composer& composer, char const* name)
+        : composer_(composer)
+        , profiler_(gate_profiler::active())
+    {
+        if (profiler_) {
+            node_ = profiler_->enter(name);
+            start_gates_ = composer_.get_num_gates();
+            start_variables_ = composer_.variables.size();
+        }
+    }
+
+    ~gate_scope()
+    {
+        if (profiler_) {
+            profiler_->exit(
+                node_, composer_.get_num_gates() - start_gates_, composer_.variables.size() - start_variables_);
+        }
+    }
+
+    gate_scope(gate_scope const&) = delete;
+    gate_scope& operator=(gate_scope const&) = delete;
+
+  private:
+    Composer& composer_;
+    gate_profiler* profiler_;
+    gate_profiler::node* node_ = nullptr;
+    size_t start_gates_ = 0;
+    size_t start_variables_ = 0;
+};
+
+} // namespace proofs
+} // namespace rollup
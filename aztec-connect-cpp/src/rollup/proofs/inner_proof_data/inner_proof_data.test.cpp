@@ -1,4 +1,5 @@
 #include "inner_proof_data.hpp"
+#include "inner_proof_view.hpp"
 #include <gtest/gtest.h>
 
 using namespace barretenberg;
@@ -6,7 +7,18 @@ using namespace rollup::proofs;
 
 namespace {
 auto& rand_engine = numeric::random::get_debug_engine();
+
+std::vector<uint8_t> create_random_proof_data()
+{
+    std::vector<uint8_t> proof_data;
+    for (size_t i = 0; i < InnerProofFields::NUM_FIELDS; ++i) {
+        write(proof_data, fr::random_element(&rand_engine));
+    }
+    // Append some non public input bytes, as found in a real proof.
+    proof_data.resize(proof_data.size() + 64, 0xab);
+    return proof_data;
 }
+} // namespace
 
 TEST(client_proofs_inner_proof_data, test_proof_to_data)
 {
@@ -65,3 +77,31 @@ TEST(client_proofs_inner_proof_data, test_proof_to_data)
     EXPECT_EQ(data.backward_link, backward_link);
     EXPECT_EQ(data.allow_chain, allow_chain);
 }
+
+TEST(client_proofs_inner_proof_data, test_view_matches_data)
+{
+    auto proof_data = create_random_proof_data();
+    auto proof_id_ptr = proof_data.data() + InnerProofOffsets::PROOF_ID;
+    write(proof_id_ptr, uint256_t(rollup::ProofIds::DEFI_DEPOSIT));
+
+    auto data = inner_proof_data(proof_data);
+    auto view = inner_proof_view(proof_data);
+
+    EXPECT_EQ(view.proof_id(), data.proof_id);
+    EXPECT_EQ(view.proof_id_u32(), static_cast<uint32_t>(rollup::ProofIds::DEFI_DEPOSIT));
+    EXPECT_EQ(view.note_commitment1(), data.note_commitment1);
+    EXPECT_EQ(view.note_commitment2(), data.note_commitment2);
+    EXPECT_EQ(view.nullifier1(), data.nullifier1);
+    EXPECT_EQ(view.nullifier2(), data.nullifier2);
+    EXPECT_EQ(view.public_value(), data.public_value);
+    EXPECT_EQ(view.public_owner(), data.public_owner);
+    EXPECT_EQ(view.asset_id(), data.asset_id);
+    EXPECT_EQ(view.merkle_root(), data.merkle_root);
+    EXPECT_EQ(view.tx_fee(), data.tx_fee);
+    EXPECT_EQ(view.tx_fee_asset_id(), data.tx_fee_asset_id);
+    EXPECT_EQ(view.bridge_call_data(), data.bridge_call_data);
+    EXPECT_EQ(view.defi_deposit_value(), data.defi_deposit_value);
+    EXPECT_EQ(view.defi_root(), data.defi_root);
+    EXPECT_EQ(view.backward_link(), data.backward_link);
+    EXPECT_EQ(view.allow_chain(), data.allow_chain);
+}
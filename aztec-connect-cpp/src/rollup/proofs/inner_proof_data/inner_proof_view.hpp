@@ -0,0 +1,49 @@
+#pragma once
+#include "inner_proof_data.hpp"
+#include <common/serialize.hpp>
+
+namespace rollup {
+namespace proofs {
+
+/**
+ * A non-owning view over the public inputs at the head of an inner proof buffer.
+ * Unlike `inner_proof_data`, nothing is copied out of the buffer up front; each field is deserialized on access.
+ * The underlying proof buffer must outlive the view.
+ */
+struct inner_proof_view {
+    uint8_t const* data;
+
+    inner_proof_view(uint8_t const* proof_data)
+        : data(proof_data)
+    {}
+    inner_proof_view(std::vector<uint8_t> const& proof_data)
+        : data(proof_data.data())
+    {}
+    // A view must not be taken over a temporary buffer.
+    inner_proof_view(std::vector<uint8_t>&&) = delete;
+
+    uint256_t proof_id() const { return read<uint256_t>(InnerProofOffsets::PROOF_ID); }
+    // The proof id is small; the rollup circuit indexes its verification keys with the low 4 bytes.
+    uint32_t proof_id_u32() const { return read<uint32_t>(InnerProofOffsets::PROOF_ID + 28); }
+    barretenberg::fr note_commitment1() const { return read<barretenberg::fr>(InnerProofOffsets::NOTE_COMMITMENT1); }
+    barretenberg::fr note_commitment2() const { return read<barretenberg::fr>(InnerProofOffsets::NOTE_COMMITMENT2); }
+    uint256_t nullifier1() const { return read<uint256_t>(InnerProofOffsets::NULLIFIER1); }
+    uint256_t nullifier2() const { return read<uint256_t>(InnerProofOffsets::NULLIFIER2); }
+    uint256_t public_value() const { return read<uint256_t>(InnerProofOffsets::PUBLIC_VALUE); }
+    barretenberg::fr public_owner() const { return read<barretenberg::fr>(InnerProofOffsets::PUBLIC_OWNER); }
+    uint256_t asset_id() const { return read<uint256_t>(InnerProofOffsets::PUBLIC_ASSET_ID); }
+    barretenberg::fr merkle_root() const { return read<barretenberg::fr>(InnerProofOffsets::MERKLE_ROOT); }
+    uint256_t tx_fee() const { return read<uint256_t>(InnerProofOffsets::TX_FEE); }
+    uint256_t tx_fee_asset_id() const { return read<uint256_t>(InnerProofOffsets::TX_FEE_ASSET_ID); }
+    uint256_t bridge_call_data() const { return read<uint256_t>(InnerProofOffsets::BRIDGE_CALL_DATA); }
+    uint256_t defi_deposit_value() const { return read<uint256_t>(InnerProofOffsets::DEFI_DEPOSIT_VALUE); }
+    barretenberg::fr defi_root() const { return read<barretenberg::fr>(InnerProofOffsets::DEFI_ROOT); }
+    barretenberg::fr backward_link() const { return read<barretenberg::fr>(InnerProofOffsets::BACKWARD_LINK); }
+    uint256_t allow_chain() const { return read<uint256_t>(InnerProofOffsets::ALLOW_CHAIN); }
+
+  private:
+    template <typename T> T read(size_t offset) const { return from_buffer<T>(data + offset); }
+};
+
+} // namespace proofs
+} // namespace rollup
@@ -2,6 +2,7 @@
 #include "join_split_circuit.hpp"
 #include "sign_join_split_tx.hpp"
 #include "../notes/native/index.hpp"
+#include "../circuit_types.hpp"
 #include <stdlib/merkle_tree/hash_path.hpp>
 
 namespace rollup {
@@ -9,7 +10,7 @@ namespace proofs {
 namespace join_split {
 
 using namespace rollup::proofs::join_split;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace rollup::proofs::notes::native;
 using namespace plonk::stdlib::merkle_tree;
 
@@ -58,7 +59,14 @@ join_split_tx noop_tx()
     return tx;
 }
 
-circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs, bool mock)
+circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs,
+                              bool mock,
+                              std::string const& key_path,
+                              bool compute,
+                              bool save,
+                              bool load,
+                              bool pk,
+                              bool vk)
 {
     std::cerr << "Getting join-split circuit data..." << std::endl;
 
@@ -68,7 +76,7 @@ circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> co
     };
 
     return proofs::get_circuit_data<Composer>(
-        "join split", "", srs, "", true, false, false, true, true, true, mock, build_circuit);
+        "join split", "join_split", srs, key_path, compute, save, load, pk, vk, true, mock, build_circuit);
 }
 
 } // namespace join_split
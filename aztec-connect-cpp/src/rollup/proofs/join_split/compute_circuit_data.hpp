@@ -10,7 +10,18 @@ join_split_tx noop_tx();
 
 using circuit_data = proofs::circuit_data;
 
-circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs, bool mock = false);
+/**
+ * Computes the join split circuit's keys and padding proof or, given a key path to persist them under, loads them
+ * from there when they've been saved, as the rollup circuits' are.
+ */
+circuit_data get_circuit_data(std::shared_ptr<waffle::ReferenceStringFactory> const& srs,
+                              bool mock = false,
+                              std::string const& key_path = "",
+                              bool compute = true,
+                              bool save = false,
+                              bool load = false,
+                              bool pk = true,
+                              bool vk = true);
 
 } // namespace join_split
 } // namespace proofs
@@ -1,7 +1,7 @@
 #include "create_noop_join_split_proof.hpp"
 #include "join_split_circuit.hpp"
+#include "../circuit_types.hpp"
 #include <stdlib/merkle_tree/hash_path.hpp>
-#include <stdlib/types/turbo.hpp>
 #include <sys/stat.h>
 
 namespace rollup {
@@ -9,7 +9,7 @@ namespace proofs {
 namespace join_split {
 
 using namespace barretenberg;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace plonk::stdlib::merkle_tree;
 
 std::vector<uint8_t> create_noop_join_split_proof(circuit_data const& circuit_data,
@@ -1,7 +1,7 @@
 #include "join_split.hpp"
 #include "join_split_circuit.hpp"
 #include "compute_circuit_data.hpp"
-#include <plonk/composer/turbo/compute_verification_key.hpp>
+#include "../../constants.hpp"
 #include <plonk/proof_system/commitment_scheme/kate_commitment_scheme.hpp>
 
 namespace rollup {
@@ -14,6 +14,26 @@ using namespace plonk::stdlib::merkle_tree;
 static std::shared_ptr<waffle::proving_key> proving_key;
 static std::shared_ptr<waffle::verification_key> verification_key;
 
+static void check_composer(Composer const& composer)
+{
+    if (composer.failed) {
+        std::string error = format("composer logic failed: ", composer.err);
+        throw_or_abort(error);
+    }
+}
+
+/**
+ * The public inputs of the circuit of `tx`, for mock proofs. The circuit is freed once they're read, rather than held
+ * while the mock circuit is built and proven.
+ */
+static std::vector<fr> build_public_inputs(join_split_tx const& tx)
+{
+    Composer composer(std::make_shared<waffle::ReferenceStringFactory>(), circuit_gate_count::JOIN_SPLIT);
+    join_split_circuit(composer, tx);
+    check_composer(composer);
+    return composer.get_public_inputs();
+}
+
 void init_proving_key(std::shared_ptr<waffle::ReferenceStringFactory> const& crs_factory, bool mock)
 {
     if (proving_key) {
@@ -23,15 +43,16 @@ void init_proving_key(std::shared_ptr<waffle::ReferenceStringFactory> const& crs
     // Junk data required just to create proving key.
     join_split_tx tx = noop_tx();
 
+    // Composers are sized for the circuit up front. Grown gate by gate, their vectors reallocate as they double,
+    // leaving freed blocks behind that a wasm heap, which never shrinks, then has to grow past.
     if (!mock) {
-        Composer composer(crs_factory);
+        Composer composer(crs_factory, circuit_gate_count::JOIN_SPLIT);
         join_split_circuit(composer, tx);
         proving_key = composer.compute_proving_key();
     } else {
-        Composer composer;
-        join_split_circuit(composer, tx);
+        auto public_inputs = build_public_inputs(tx);
         Composer mock_proof_composer(crs_factory);
-        rollup::proofs::mock::mock_circuit(mock_proof_composer, composer.get_public_inputs());
+        rollup::proofs::mock::mock_circuit(mock_proof_composer, public_inputs);
         proving_key = mock_proof_composer.compute_proving_key();
     }
 }
@@ -54,7 +75,7 @@ void init_verification_key(std::unique_ptr<waffle::ReferenceStringFactory>&& crs
     }
     // Patch the 'nothing' reference string fed to init_proving_key.
     proving_key->reference_string = crs_factory->get_prover_crs(proving_key->n + 1);
-    verification_key = waffle::turbo_composer::compute_verification_key(proving_key, crs_factory->get_verifier_crs());
+    verification_key = circuit_types::compute_verification_key(proving_key, crs_factory->get_verifier_crs());
 }
 
 void init_verification_key(std::shared_ptr<waffle::VerifierMemReferenceString> const& crs,
@@ -63,24 +84,26 @@ void init_verification_key(std::shared_ptr<waffle::VerifierMemReferenceString> c
     verification_key = std::make_shared<waffle::verification_key>(std::move(vk_data), crs);
 }
 
+/**
+ * Proves with the whole proving key in memory, and all of the prover's polynomials held until the proof is done. A
+ * lower memory prover, holding only the polynomials of the current round and streaming the rest from the serialized
+ * key, is not implemented: the rounds and their polynomials are barretenberg's prover's, which this repository
+ * doesn't contain. `proof_peak_memory` bounds what a proof takes as it is, in wasm.
+ */
 UnrolledProver new_join_split_prover(join_split_tx const& tx, bool mock)
 {
-    Composer composer(proving_key, nullptr);
-    join_split_circuit(composer, tx);
-
-    if (composer.failed) {
-        std::string error = format("composer logic failed: ", composer.err);
-        throw_or_abort(error);
-    }
-
-    info("public inputs: ", composer.public_inputs.size());
-
     if (!mock) {
+        Composer composer(proving_key, nullptr, circuit_gate_count::JOIN_SPLIT);
+        join_split_circuit(composer, tx);
+        check_composer(composer);
+        info("public inputs: ", composer.public_inputs.size());
         info("composer gates: ", composer.get_num_gates());
         return composer.create_unrolled_prover();
     } else {
+        auto public_inputs = build_public_inputs(tx);
+        info("public inputs: ", public_inputs.size());
         Composer mock_proof_composer(proving_key, nullptr);
-        rollup::proofs::mock::mock_circuit(mock_proof_composer, composer.get_public_inputs());
+        rollup::proofs::mock::mock_circuit(mock_proof_composer, public_inputs);
         info("mock composer gates: ", mock_proof_composer.get_num_gates());
         return mock_proof_composer.create_unrolled_prover();
     }
@@ -91,8 +114,8 @@ bool verify_proof(waffle::plonk_proof const& proof)
     UnrolledVerifier verifier(verification_key,
                               Composer::create_unrolled_manifest(verification_key->num_public_inputs));
 
-    std::unique_ptr<waffle::KateCommitmentScheme<waffle::unrolled_turbo_settings>> kate_commitment_scheme =
-        std::make_unique<waffle::KateCommitmentScheme<waffle::unrolled_turbo_settings>>();
+    std::unique_ptr<waffle::KateCommitmentScheme<circuit_types::unrolled_program_settings>> kate_commitment_scheme =
+        std::make_unique<waffle::KateCommitmentScheme<circuit_types::unrolled_program_settings>>();
     verifier.commitment_scheme = std::move(kate_commitment_scheme);
 
     return verifier.verify_proof(proof);
@@ -2,14 +2,14 @@
 #include "join_split_tx.hpp"
 #include "../notes/circuit/value/witness_data.hpp"
 #include "../notes/circuit/claim/witness_data.hpp"
+#include "../circuit_types.hpp"
 #include <crypto/schnorr/schnorr.hpp>
-#include <stdlib/types/turbo.hpp>
 
 namespace rollup {
 namespace proofs {
 namespace join_split {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 struct join_split_inputs {
     field_ct proof_id;
@@ -2,6 +2,7 @@
 #include "../inner_proof_data/inner_proof_data.hpp"
 #include "index.hpp"
 #include "../notes/native/index.hpp"
+#include "../circuit_types.hpp"
 #include <common/streams.hpp>
 #include <common/test.hpp>
 #include <plonk/proof_system/proving_key/serialize.hpp>
@@ -13,7 +14,7 @@ namespace proofs {
 namespace join_split {
 
 using namespace barretenberg;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace plonk::stdlib::merkle_tree;
 using namespace rollup::proofs::notes::native;
 using key_pair = rollup::fixtures::grumpkin_key_pair;
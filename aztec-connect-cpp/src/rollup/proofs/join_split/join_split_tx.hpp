@@ -1,15 +1,15 @@
 #pragma once
 #include "../notes/native/claim/claim_note_tx_data.hpp"
 #include "../notes/native/value/value_note.hpp"
+#include "../circuit_types.hpp"
 #include <crypto/schnorr/schnorr.hpp>
 #include <stdlib/merkle_tree/hash_path.hpp>
-#include <stdlib/types/turbo.hpp>
 
 namespace rollup {
 namespace proofs {
 namespace join_split {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 struct join_split_tx {
     uint32_t proof_id;
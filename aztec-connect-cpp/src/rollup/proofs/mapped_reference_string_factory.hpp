@@ -0,0 +1,184 @@
+#pragma once
+#include <common/log.hpp>
+#include <common/throw_or_abort.hpp>
+#include <ecc/curves/bn254/scalar_multiplication/pippenger.hpp>
+#include <plonk/reference_string/file_reference_string.hpp>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rollup {
+namespace proofs {
+
+/**
+ * A pippenger point table (each SRS point followed by its endomorphism, as held in memory, so in Montgomery form),
+ * memory mapped from a file built once from the transcripts.
+ *
+ * File layout: a header of `HEADER_SIZE` bytes holding `MAGIC` and the number of SRS points, then the table.
+ * Entries of the table depend only on their own point, so a table of n points is a prefix of any larger one.
+ *
+ * The mapping is private (copy on write), so until written its pages are the page cache's: shared by every process
+ * mapping the file, and only read from disk when first touched.
+ */
+class mapped_point_table {
+  public:
+    static constexpr uint64_t MAGIC = 0x3130656c62617470; // "ptable01"
+    static constexpr size_t HEADER_SIZE = 64;
+
+    // Maps the table at `path`. Returns nullptr if there is no file there, or it isn't a complete point table.
+    static std::shared_ptr<mapped_point_table> open(std::string const& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat st;
+        uint64_t header[2] = { 0, 0 };
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE ||
+            pread(fd, header, sizeof(header), 0) != sizeof(header) || header[0] != MAGIC ||
+            static_cast<size_t>(st.st_size) != HEADER_SIZE + header[1] * 2 * sizeof(barretenberg::g1::affine_element)) {
+            info("Ignoring invalid point table: ", path);
+            close(fd);
+            return nullptr;
+        }
+        auto size = static_cast<size_t>(st.st_size);
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw_or_abort(format("Failed to map: ", path));
+        }
+        return std::shared_ptr<mapped_point_table>(new mapped_point_table(data, size, header[1]));
+    }
+
+    ~mapped_point_table() { munmap(data_, size_); }
+
+    mapped_point_table(mapped_point_table const&) = delete;
+    mapped_point_table& operator=(mapped_point_table const&) = delete;
+
+    size_t num_points() const { return num_points_; }
+
+    barretenberg::g1::affine_element* points() const
+    {
+        return reinterpret_cast<barretenberg::g1::affine_element*>(static_cast<uint8_t*>(data_) + HEADER_SIZE);
+    }
+
+    /**
+     * Builds the table of the first `num_points` points of the transcripts in `srs_path`, and writes it to `path`.
+     * Written to a temporary file and renamed into place, so processes already mapping an older file are unaffected.
+     * Processes building at once take turns to rename theirs into place, and a table never replaces a larger one.
+     */
+    static void build(std::string const& srs_path, std::string const& path, size_t num_points)
+    {
+        info("Building point table of ", num_points, " points: ", path);
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+        barretenberg::scalar_multiplication::Pippenger pippenger(srs_path, num_points);
+        auto tmp_path = format(path, ".", getpid(), ".tmp");
+        {
+            std::ofstream os(tmp_path, std::ios::binary);
+            uint64_t header[HEADER_SIZE / sizeof(uint64_t)] = { MAGIC, num_points };
+            os.write(reinterpret_cast<char const*>(header), HEADER_SIZE);
+            os.write(reinterpret_cast<char const*>(pippenger.get_point_table()),
+                     static_cast<std::streamsize>(num_points * 2 * sizeof(barretenberg::g1::affine_element)));
+            if (!os.good()) {
+                throw_or_abort(format("Failed to write: ", tmp_path));
+            }
+        }
+
+        auto lock_path = path + ".lock";
+        int lock_fd = ::open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (lock_fd < 0 || flock(lock_fd, LOCK_EX) != 0) {
+            throw_or_abort(format("Failed to lock: ", lock_path));
+        }
+        std::error_code ec;
+        auto existing = open(path);
+        if (existing && existing->num_points() >= num_points) {
+            info("Keeping the larger point table of ", existing->num_points(), " points: ", path);
+            std::filesystem::remove(tmp_path, ec);
+        } else {
+            std::filesystem::rename(tmp_path, path, ec);
+        }
+        existing.reset();
+        flock(lock_fd, LOCK_UN);
+        close(lock_fd);
+        if (ec) {
+            throw_or_abort(format("Failed to replace: ", path, ": ", ec.message()));
+        }
+    }
+
+  private:
+    mapped_point_table(void* data, size_t size, size_t num_points)
+        : data_(data)
+        , size_(size)
+        , num_points_(num_points)
+    {}
+
+    void* data_;
+    size_t size_;
+    size_t num_points_;
+};
+
+// A prover reference string of some degree, viewing the prefix of a mapped point table.
+class mapped_prover_reference_string : public waffle::ProverReferenceString {
+  public:
+    explicit mapped_prover_reference_string(std::shared_ptr<mapped_point_table> const& table)
+        : table_(table)
+    {}
+
+    barretenberg::g1::affine_element* get_monomials() override { return table_->points(); }
+
+  private:
+    std::shared_ptr<mapped_point_table> table_;
+};
+
+/**
+ * Serves prover reference strings of every degree from one memory mapped point table, kept in `cache_dir`.
+ *
+ * Unlike a DynamicFileReferenceStringFactory, which reads the transcripts and computes a point table for each degree
+ * asked for, the table is built once, for the largest degree asked for yet, and persisted. Every request it is large
+ * enough for, from this process or another, only maps it. Safe to use from several threads.
+ *
+ * The transcripts are often on a read only mount, so the table is kept apart from them, in a directory the caller
+ * can write to, such as its data path.
+ */
+class mapped_reference_string_factory : public waffle::ReferenceStringFactory {
+  public:
+    mapped_reference_string_factory(std::string const& srs_path, std::string const& cache_dir)
+        : srs_path_(srs_path)
+        , table_path_(cache_dir + "/point_table")
+        , verifier_crs_(std::make_shared<waffle::VerifierFileReferenceString>(srs_path))
+    {}
+
+    std::shared_ptr<waffle::ProverReferenceString> get_prover_crs(size_t degree) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!table_ || table_->num_points() < degree) {
+            // Another process may have built a larger table since this one was mapped.
+            table_ = mapped_point_table::open(table_path_);
+            if (!table_ || table_->num_points() < degree) {
+                mapped_point_table::build(srs_path_, table_path_, degree);
+                table_ = mapped_point_table::open(table_path_);
+            }
+            if (!table_) {
+                throw_or_abort(format("Failed to build point table: ", table_path_));
+            }
+        }
+        return std::make_shared<mapped_prover_reference_string>(table_);
+    }
+
+    std::shared_ptr<waffle::VerifierReferenceString> get_verifier_crs() override { return verifier_crs_; }
+
+  private:
+    std::string srs_path_;
+    std::string table_path_;
+    std::shared_ptr<waffle::VerifierReferenceString> verifier_crs_;
+    std::shared_ptr<mapped_point_table> table_;
+    std::mutex mutex_;
+};
+
+} // namespace proofs
+} // namespace rollup
@@ -0,0 +1,66 @@
+#include "mapped_reference_string_factory.hpp"
+#include "standard_example/standard_example.hpp"
+#include <gtest/gtest.h>
+
+using namespace barretenberg;
+using namespace rollup::proofs;
+
+namespace {
+constexpr auto SRS_PATH = "../barretenberg/cpp/srs_db/ignition";
+
+class mapped_reference_string_factory_tests : public ::testing::Test {
+  protected:
+    mapped_reference_string_factory_tests()
+        : cache_dir((std::filesystem::temp_directory_path() / "mapped_reference_string_factory_test").string())
+        , table_path(cache_dir + "/point_table")
+    {
+        std::filesystem::remove_all(cache_dir);
+    }
+
+    ~mapped_reference_string_factory_tests() { std::filesystem::remove_all(cache_dir); }
+
+    std::string cache_dir;
+    std::string table_path;
+};
+} // namespace
+
+TEST_F(mapped_reference_string_factory_tests, proves_with_mapped_point_table)
+{
+    // The first factory builds the table, the second only maps it.
+    for (size_t i = 0; i < 2; ++i) {
+        auto crs = std::make_shared<mapped_reference_string_factory>(SRS_PATH, cache_dir);
+        standard_example::Composer composer(crs);
+        standard_example::build_circuit(composer);
+
+        auto prover = composer.create_prover();
+        waffle::plonk_proof proof = prover.construct_proof();
+
+        auto verifier = composer.create_verifier();
+        EXPECT_TRUE(verifier.verify_proof(proof));
+        EXPECT_TRUE(std::filesystem::exists(table_path));
+    }
+
+    // A table is a prefix of any larger one.
+    scalar_multiplication::Pippenger pippenger(SRS_PATH, 1024);
+    auto table = mapped_point_table::open(table_path);
+    ASSERT_TRUE(table);
+    ASSERT_GE(table->num_points(), 1024UL);
+    for (size_t i = 0; i < 2048; ++i) {
+        EXPECT_EQ(table->points()[i], pippenger.get_point_table()[i]);
+    }
+}
+
+TEST_F(mapped_reference_string_factory_tests, smaller_table_never_replaces_larger)
+{
+    mapped_point_table::build(SRS_PATH, table_path, 2048);
+    mapped_point_table::build(SRS_PATH, table_path, 1024);
+
+    auto table = mapped_point_table::open(table_path);
+    ASSERT_TRUE(table);
+    EXPECT_EQ(table->num_points(), 2048UL);
+
+    mapped_point_table::build(SRS_PATH, table_path, 4096);
+    table = mapped_point_table::open(table_path);
+    ASSERT_TRUE(table);
+    EXPECT_EQ(table->num_points(), 4096UL);
+}
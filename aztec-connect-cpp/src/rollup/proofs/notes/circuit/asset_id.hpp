@@ -1,9 +1,9 @@
 #pragma once
-#include <stdlib/types/turbo.hpp>
+#include "../../circuit_types.hpp"
 
 namespace rollup::proofs::notes::circuit {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 std::pair<bool_ct, suint_ct> deflag_asset_id(suint_ct const& asset_id);
 
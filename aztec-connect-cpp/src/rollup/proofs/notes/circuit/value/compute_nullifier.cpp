@@ -1,6 +1,6 @@
 #include "compute_nullifier.hpp"
 #include "../../constants.hpp"
-#include <stdlib/types/turbo.hpp>
+#include "../../../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
@@ -8,7 +8,7 @@ namespace notes {
 namespace circuit {
 
 using namespace barretenberg;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 field_ct compute_nullifier(field_ct const& note_commitment,
                            field_ct const& account_private_key,
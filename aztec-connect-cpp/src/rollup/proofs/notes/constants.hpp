@@ -30,6 +30,10 @@ enum GeneratorIndex {
     ACCOUNT_ALIAS_HASH_NULLIFIER,
     DEFI_INTERACTION_NULLIFIER,
     ACCOUNT_PUBLIC_KEY_NULLIFIER,
+
+    ROLLUP_CHAINED_TXS_CHALLENGE,
+    INDEXED_NULLIFIER_LEAF,
+    ROLLUP_SLOT_LOOKUP_CHALLENGE,
 };
 
 constexpr uint32_t DEFI_BRIDGE_ADDRESS_ID_LEN = 32;
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#ifndef __wasm__
+#include <sys/resource.h>
+#endif
+
+namespace rollup {
+namespace proofs {
+
+/**
+ * The most memory this process has held. In wasm that's the size of linear memory, which only ever grows. Natively
+ * it's the peak resident set size.
+ */
+inline size_t peak_memory_bytes()
+{
+#ifdef __wasm__
+    return __builtin_wasm_memory_size(0) * 65536;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    // Reported in KiB on Linux.
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+} // namespace proofs
+} // namespace rollup
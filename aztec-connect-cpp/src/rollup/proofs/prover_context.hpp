@@ -0,0 +1,118 @@
+#pragma once
+#include "circuit_types.hpp"
+#include "mock/mock_circuit.hpp"
+#include <common/log.hpp>
+#include <common/throw_or_abort.hpp>
+#include <array>
+#include <functional>
+
+namespace rollup {
+namespace proofs {
+
+/**
+ * The variable and gate storage of a composer, kept between the proofs of a prover context. Each proof's composer
+ * builds its circuit into the buffers of the last, already allocated at their full size and faulted in, rather than
+ * allocating its own and growing them gate by gate. The prover's polynomials are allocated inside barretenberg, and
+ * aren't kept.
+ */
+struct composer_workspace {
+    std::vector<barretenberg::fr> variables;
+    std::vector<uint32_t> real_variable_index;
+    std::array<std::vector<uint32_t>, 4> wires;
+    std::vector<std::vector<barretenberg::fr>> selectors;
+
+    // Hands the kept buffers to a newly constructed composer, with whatever its constructor put in its own.
+    template <typename Composer> void lend(Composer& composer)
+    {
+        adopt(composer.variables, variables);
+        adopt(composer.real_variable_index, real_variable_index);
+        adopt(composer.w_l, wires[0]);
+        adopt(composer.w_r, wires[1]);
+        adopt(composer.w_o, wires[2]);
+        adopt(composer.w_4, wires[3]);
+        selectors.resize(composer.selectors.size());
+        for (size_t i = 0; i < selectors.size(); ++i) {
+            adopt(composer.selectors[i], selectors[i]);
+        }
+    }
+
+    // Takes the buffers back from a composer whose proof is done.
+    template <typename Composer> void reclaim(Composer& composer)
+    {
+        variables = std::move(composer.variables);
+        real_variable_index = std::move(composer.real_variable_index);
+        wires = { std::move(composer.w_l), std::move(composer.w_r), std::move(composer.w_o), std::move(composer.w_4) };
+        selectors = std::move(composer.selectors);
+    }
+
+  private:
+    template <typename T> static void adopt(std::vector<T>& to, std::vector<T>& from)
+    {
+        if (from.capacity() <= to.capacity()) {
+            return;
+        }
+        from.assign(to.begin(), to.end());
+        to.swap(from);
+    }
+};
+
+/**
+ * Proves transactions of one circuit back to back, as a service proving many of them in sequence does.
+ *
+ * The context holds the circuit's proving key, and a workspace the composer of each proof builds the circuit in, kept
+ * from one proof to the next. In mock mode the full circuit is still built, for the public inputs the mock proof
+ * commits to. Not safe to use from several threads at once: use a context per thread.
+ */
+template <typename Tx> class prover_context {
+  public:
+    using circuit_builder = std::function<void(circuit_types::Composer&, Tx const&)>;
+
+    prover_context(std::shared_ptr<waffle::proving_key> const& proving_key, circuit_builder const& build, bool mock)
+        : proving_key_(proving_key)
+        , build_(build)
+        , mock_(mock)
+    {
+        if (!proving_key_) {
+            throw_or_abort("Prover context needs a proving key.");
+        }
+    }
+
+    std::vector<uint8_t> prove(Tx const& tx)
+    {
+        circuit_types::Composer composer(proving_key_, nullptr);
+        workspace_.lend(composer);
+        build_(composer, tx);
+        if (composer.failed) {
+            workspace_.reclaim(composer);
+            throw_or_abort(format("composer logic failed: ", composer.err));
+        }
+        num_proofs_++;
+
+        std::vector<uint8_t> proof;
+        if (!mock_) {
+            auto prover = composer.create_unrolled_prover();
+            proof = prover.construct_proof().proof_data;
+        } else {
+            circuit_types::Composer mock_proof_composer(proving_key_, nullptr);
+            mock::mock_circuit(mock_proof_composer, composer.get_public_inputs());
+            auto prover = mock_proof_composer.create_unrolled_prover();
+            proof = prover.construct_proof().proof_data;
+        }
+        workspace_.reclaim(composer);
+        return proof;
+    }
+
+    size_t num_proofs() const { return num_proofs_; }
+
+    composer_workspace const& workspace() const { return workspace_; }
+
+  private:
+    std::shared_ptr<waffle::proving_key> proving_key_;
+    circuit_builder build_;
+    bool mock_;
+    composer_workspace workspace_;
+    size_t num_proofs_ = 0;
+};
+
+} // namespace proofs
+} // namespace rollup
@@ -0,0 +1,151 @@
+#pragma once
+#include <common/log.hpp>
+#include <common/throw_or_abort.hpp>
+#include <plonk/proof_system/proving_key/proving_key.hpp>
+#include <plonk/proof_system/proving_key/serialize.hpp>
+#include <deque>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+/**
+ * Serializing a proving key in pieces, so exporting or importing one needs memory for about one key rather than for
+ * the key and all of its serialized form.
+ */
+namespace rollup {
+namespace proofs {
+
+using proving_key_chunk_callback = void (*)(void* ctx, uint8_t const* chunk, uint32_t length);
+
+// Counts the bytes written to it, and discards them.
+class counting_streambuf : public std::streambuf {
+  public:
+    size_t size() const { return size_; }
+
+  protected:
+    std::streamsize xsputn(char const*, std::streamsize n) override
+    {
+        size_ += static_cast<size_t>(n);
+        return n;
+    }
+
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            size_++;
+        }
+        return traits_type::not_eof(ch);
+    }
+
+  private:
+    size_t size_ = 0;
+};
+
+// Buffers what's written to it, and hands it to a callback a chunk at a time.
+class chunk_streambuf : public std::streambuf {
+  public:
+    chunk_streambuf(proving_key_chunk_callback callback, void* ctx, size_t chunk_size)
+        : callback_(callback)
+        , ctx_(ctx)
+        , buf_(chunk_size)
+    {
+        setp(buf_.data(), buf_.data() + buf_.size());
+    }
+
+  protected:
+    int_type overflow(int_type ch) override
+    {
+        flush();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override
+    {
+        flush();
+        return 0;
+    }
+
+  private:
+    void flush()
+    {
+        if (pptr() != pbase()) {
+            callback_(ctx_, reinterpret_cast<uint8_t const*>(pbase()), static_cast<uint32_t>(pptr() - pbase()));
+        }
+        setp(buf_.data(), buf_.data() + buf_.size());
+    }
+
+    proving_key_chunk_callback callback_;
+    void* ctx_;
+    std::vector<char> buf_;
+};
+
+// The exact size of the serialized key, without holding it.
+inline size_t serialized_proving_key_size(waffle::proving_key const& key)
+{
+    counting_streambuf buf;
+    std::ostream os(&buf);
+    write(os, key);
+    return buf.size();
+}
+
+// Serializes the key through `callback`, in chunks of at most `chunk_size` bytes.
+inline void write_proving_key_chunks(waffle::proving_key const& key,
+                                     proving_key_chunk_callback callback,
+                                     void* ctx,
+                                     size_t chunk_size = 1024 * 1024)
+{
+    chunk_streambuf buf(callback, ctx, chunk_size);
+    std::ostream os(&buf);
+    write(os, key);
+    os.flush();
+}
+
+/**
+ * Collects a serialized proving key a chunk at a time, then deserializes it. Each chunk is freed as soon as it has
+ * been read, so while the key is read, what's left of its serialized form shrinks as the key grows.
+ */
+class proving_key_reader : private std::streambuf {
+  public:
+    void add_chunk(uint8_t const* chunk, size_t length) { chunks_.emplace_back(chunk, chunk + length); }
+
+    waffle::proving_key_data read_key()
+    {
+        std::istream is(this);
+        waffle::proving_key_data pk_data;
+        read(is, pk_data);
+        if (!is.good()) {
+            throw_or_abort("Truncated proving key.");
+        }
+        if (!chunks_.empty() || gptr() != egptr()) {
+            info("Ignoring trailing bytes after proving key.");
+        }
+        return pk_data;
+    }
+
+  protected:
+    int_type underflow() override
+    {
+        while (gptr() == egptr()) {
+            if (chunks_.empty()) {
+                return traits_type::eof();
+            }
+            current_ = std::move(chunks_.front());
+            chunks_.pop_front();
+            auto data = reinterpret_cast<char*>(current_.data());
+            setg(data, data, data + current_.size());
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+  private:
+    std::deque<std::vector<uint8_t>> chunks_;
+    std::vector<uint8_t> current_;
+};
+
+} // namespace proofs
+} // namespace rollup
@@ -17,6 +17,10 @@ struct circuit_data : proofs::circuit_data {
     size_t num_txs;
     std::vector<std::shared_ptr<waffle::verification_key>> verification_keys;
     join_split::circuit_data join_split_circuit_data;
+    ChainingCheck chaining_check = ChainingCheck::QUADRATIC;
+    NullifierTree nullifier_tree = NullifierTree::SPARSE;
+    SlotMatching slot_matching = SlotMatching::SCAN;
+    MembershipChecks membership_checks;
 };
 
 inline circuit_data get_circuit_data(size_t rollup_size,
@@ -30,13 +34,30 @@ inline circuit_data get_circuit_data(size_t rollup_size,
                                      bool load = true,
                                      bool pk = true,
                                      bool vk = true,
-                                     bool mock = false)
+                                     bool mock = false,
+                                     ChainingCheck chaining_check = ChainingCheck::QUADRATIC,
+                                     NullifierTree nullifier_tree = NullifierTree::SPARSE,
+                                     SlotMatching slot_matching = SlotMatching::SCAN,
+                                     MembershipChecks membership_checks = {})
 {
     auto floor_max_txs = 1UL << numeric::get_msb(rollup_size);
     auto rollup_size_pow2 = rollup_size == floor_max_txs ? rollup_size : floor_max_txs << 1UL;
     std::cerr << "Getting tx rollup circuit data: (txs: " << rollup_size << ", size: " << rollup_size_pow2 << ")"
               << std::endl;
     auto name = "rollup_" + std::to_string(rollup_size);
+    if (chaining_check == ChainingCheck::MULTISET) {
+        name += "_multiset_chaining";
+    }
+    if (nullifier_tree == NullifierTree::INDEXED) {
+        name += "_indexed_nullifiers";
+    }
+    if (slot_matching == SlotMatching::LOOKUP) {
+        name += "_lookup_slot_matching";
+    }
+    if (membership_checks.num_data_roots || membership_checks.num_linked_commitments) {
+        name += "_membership_checks_" + std::to_string(membership_checks.num_data_roots) + "_" +
+                std::to_string(membership_checks.num_linked_commitments);
+    }
     auto verification_keys = { join_split_circuit_data.verification_key, // padding
                                join_split_circuit_data.verification_key, // deposit
                                join_split_circuit_data.verification_key, // withdraw
@@ -47,7 +68,14 @@ inline circuit_data get_circuit_data(size_t rollup_size,
 
     auto build_circuit = [&](Composer& composer) {
         auto rollup = create_padding_rollup(rollup_size, join_split_circuit_data.padding_proof);
-        rollup_circuit(composer, rollup, verification_keys, rollup_size);
+        rollup_circuit(composer,
+                       rollup,
+                       verification_keys,
+                       rollup_size,
+                       chaining_check,
+                       nullifier_tree,
+                       slot_matching,
+                       membership_checks);
     };
 
     auto cd =
@@ -63,10 +91,12 @@ inline circuit_data get_circuit_data(size_t rollup_size,
                                            true,
                                            mock,
                                            build_circuit,
-                                           " " + std::to_string(rollup_size) + "x" + std::to_string(rollup_size_pow2));
+                                           " " + std::to_string(rollup_size) + "x" + std::to_string(rollup_size_pow2),
+                                           verification_keys);
 
     circuit_data data;
     data.num_gates = cd.num_gates;
+    data.shape = cd.shape;
     data.padding_proof = cd.padding_proof;
     data.proving_key = cd.proving_key;
     data.verification_key = cd.verification_key;
@@ -74,6 +104,10 @@ inline circuit_data get_circuit_data(size_t rollup_size,
     data.num_txs = rollup_size;
     data.rollup_size = rollup_size_pow2;
     data.join_split_circuit_data = join_split_circuit_data;
+    data.chaining_check = chaining_check;
+    data.nullifier_tree = nullifier_tree;
+    data.slot_matching = slot_matching;
+    data.membership_checks = membership_checks;
     data.srs = cd.srs;
     data.mock = cd.mock;
 
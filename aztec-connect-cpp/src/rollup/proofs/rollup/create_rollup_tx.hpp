@@ -1,6 +1,6 @@
 #pragma once
 #include "rollup_tx.hpp"
-#include "../inner_proof_data/inner_proof_data.hpp"
+#include "../inner_proof_data/inner_proof_view.hpp"
 #include "../../constants.hpp"
 #include "../../world_state/world_state.hpp"
 #include "../notes/native/claim/index.hpp"
@@ -37,6 +37,11 @@ inline void pad_rollup_tx(rollup_tx& rollup, size_t rollup_size, std::vector<uin
     rollup.bridge_call_datas.resize(NUM_BRIDGE_CALLS_PER_BLOCK);
     rollup.num_asset_ids = rollup.asset_ids.size();
     rollup.asset_ids.resize(NUM_ASSETS);
+
+    // Absent when the tx was not created natively, in which case it can only be used with the sparse nullifier tree.
+    if (!rollup.indexed_null_insertions.empty()) {
+        rollup.indexed_null_insertions.resize(rollup_size * 2, rollup.indexed_null_insertions.back());
+    }
 }
 
 /**
@@ -82,6 +87,11 @@ template <typename T> inline rollup_tx create_empty_rollup(T& world_state)
                          .num_defi_interactions = 0,
                          .num_asset_ids = 0 };
 
+    if (world_state.indexed_null_tree) {
+        rollup.old_indexed_null_root = world_state.indexed_null_tree->root();
+        rollup.indexed_null_insertions = { world_state.indexed_null_tree->insert(0) };
+    }
+
     return rollup;
 }
 
@@ -91,6 +101,8 @@ template <typename T> inline rollup_tx create_empty_rollup(T& world_state)
 inline rollup_tx create_padding_rollup(size_t rollup_size, std::vector<uint8_t> const& padding_proof)
 {
     world_state::WorldState<MemoryStore> world_state;
+    // Padding serves circuits of either nullifier tree.
+    world_state.enable_indexed_null_tree();
     auto rollup = create_empty_rollup(world_state);
     pad_rollup_tx(rollup, rollup_size, padding_proof);
     return rollup;
@@ -134,12 +146,24 @@ inline rollup_tx create_rollup_tx(WorldState& world_state,
     std::vector<uint32_t> data_roots_indicies(data_roots_indicies_);
     data_roots_indicies.resize(num_txs, (uint32_t)root_tree.size() - 1);
 
+    std::vector<fr> distinct_data_roots;
+    std::vector<fr_hash_path> distinct_data_roots_paths;
+    std::vector<uint32_t> distinct_data_roots_indicies;
+    std::vector<fr> distinct_linked_commitments;
+    std::vector<fr_hash_path> distinct_linked_commitment_paths;
+    std::vector<uint32_t> distinct_linked_commitment_indices;
+    auto is_new = [](std::vector<fr> const& values, fr const& value) {
+        return std::find(values.begin(), values.end(), value) == values.end();
+    };
+
     for (size_t i = 0; i < num_txs; ++i) {
-        auto tx = inner_proof_data(txs[i]);
+        // Read fields on demand from the proof buffer, rather than copying every public input out of it.
+        const auto tx = inner_proof_view(txs[i]);
+        const auto backward_link = tx.backward_link();
 
         // Chaining - identify 'split chains' and push a valid merkle membership path.
         fr_hash_path linked_commitment_path;
-        const bool chaining = tx.backward_link != 0;
+        const bool chaining = backward_link != 0;
         bool is_propagating_prev_output1;
         bool is_propagating_prev_output2;
         if (chaining) {
@@ -147,12 +171,12 @@ inline rollup_tx create_rollup_tx(WorldState& world_state,
             fr prev_allow_chain = 0;
             // Loop through all prior txs to find a tx that this tx is chaining from (if it exists in this rollup):
             for (size_t j = 0; j < num_txs; j++) {
-                const auto prev_tx = inner_proof_data(txs[j]);
-                is_propagating_prev_output1 = prev_tx.note_commitment1 == tx.backward_link;
-                is_propagating_prev_output2 = prev_tx.note_commitment2 == tx.backward_link;
+                const auto prev_tx = inner_proof_view(txs[j]);
+                is_propagating_prev_output1 = prev_tx.note_commitment1() == backward_link;
+                is_propagating_prev_output2 = prev_tx.note_commitment2() == backward_link;
                 found_link_in_rollup = is_propagating_prev_output1 || is_propagating_prev_output2;
                 if (found_link_in_rollup) {
-                    prev_allow_chain = prev_tx.allow_chain;
+                    prev_allow_chain = prev_tx.allow_chain();
                     break;
                 }
             }
@@ -162,6 +186,11 @@ inline rollup_tx create_rollup_tx(WorldState& world_state,
                 // Then no earlier txs in this tx's chain have been included in this rollup, so we'll need to provide a
                 // valid merkle membership witness for the input note being propagated:
                 linked_commitment_paths.push_back(data_tree.get_hash_path(linked_commitment_indices[i]));
+                if (is_new(distinct_linked_commitments, backward_link)) {
+                    distinct_linked_commitments.push_back(backward_link);
+                    distinct_linked_commitment_paths.push_back(linked_commitment_paths.back());
+                    distinct_linked_commitment_indices.push_back(linked_commitment_indices[i]);
+                }
             } else {
                 // This tx is not the first tx of its chain to be included in this rollup, hence the existence of the
                 // input note being propagated is inductively assured by earlier checks in this circuit.
@@ -181,23 +210,31 @@ inline rollup_tx create_rollup_tx(WorldState& world_state,
         linked_commitment_paths.push_back(linked_commitment_path);
 
         // Compute partial claim notes
-        if (tx.proof_id == ProofIds::DEFI_DEPOSIT) {
+        auto note_commitment1 = tx.note_commitment1();
+        if (tx.proof_id() == ProofIds::DEFI_DEPOSIT) {
+            const auto bridge_call_data = tx.bridge_call_data();
             uint32_t nonce = 0;
-            while (tx.bridge_call_data != bridge_call_datas[nonce] && nonce < bridge_call_datas.size()) {
+            while (bridge_call_data != bridge_call_datas[nonce] && nonce < bridge_call_datas.size()) {
                 ++nonce;
             };
             nonce += rollup_id * NUM_BRIDGE_CALLS_PER_BLOCK;
-            uint256_t fee = tx.tx_fee - (tx.tx_fee >> 1);
-            tx.note_commitment1 = notes::native::claim::complete_partial_commitment(tx.note_commitment1, nonce, fee);
+            const auto tx_fee = tx.tx_fee();
+            uint256_t fee = tx_fee - (tx_fee >> 1);
+            note_commitment1 = notes::native::claim::complete_partial_commitment(note_commitment1, nonce, fee);
         }
 
-        data_tree_values.push_back(tx.note_commitment1);
-        data_tree_values.push_back(tx.note_commitment2);
+        data_tree_values.push_back(note_commitment1);
+        data_tree_values.push_back(tx.note_commitment2());
 
         data_roots_paths.push_back(root_tree.get_hash_path(data_roots_indicies[i]));
+        if (is_new(distinct_data_roots, tx.merkle_root())) {
+            distinct_data_roots.push_back(tx.merkle_root());
+            distinct_data_roots_paths.push_back(data_roots_paths.back());
+            distinct_data_roots_indicies.push_back(data_roots_indicies[i]);
+        }
 
-        nullifier_indicies.push_back(uint256_t(tx.nullifier1));
-        nullifier_indicies.push_back(uint256_t(tx.nullifier2));
+        nullifier_indicies.push_back(tx.nullifier1());
+        nullifier_indicies.push_back(tx.nullifier2());
     }
 
     // Insert data tree elements.
@@ -222,6 +259,17 @@ inline rollup_tx create_rollup_tx(WorldState& world_state,
         new_null_roots.push_back(null_tree.root());
     }
 
+    // Compute indexed nullifier tree data, if the world state tracks it.
+    auto* indexed_null_tree = world_state.indexed_null_tree.get();
+    fr old_indexed_null_root = 0;
+    std::vector<indexed_nullifier_insertion> indexed_null_insertions;
+    if (indexed_null_tree) {
+        old_indexed_null_root = indexed_null_tree->root();
+        for (auto& nullifier : nullifier_indicies) {
+            indexed_null_insertions.push_back(indexed_null_tree->insert(fr(nullifier)));
+        }
+    }
+
     // Compute root tree data.
     auto root_tree_root = root_tree.root();
 
@@ -252,7 +300,17 @@ inline rollup_tx create_rollup_tx(WorldState& world_state,
                          asset_ids,
 
                          bridge_call_datas.size(),
-                         asset_ids.size() };
+                         asset_ids.size(),
+
+                         old_indexed_null_root,
+                         indexed_null_insertions,
+
+                         distinct_data_roots,
+                         distinct_data_roots_paths,
+                         distinct_data_roots_indicies,
+                         distinct_linked_commitments,
+                         distinct_linked_commitment_paths,
+                         distinct_linked_commitment_indices };
 
     // Add nullifier 0 index padding data if necessary.
     if (num_txs < rollup_size) {
@@ -260,6 +318,9 @@ inline rollup_tx create_rollup_tx(WorldState& world_state,
 
         auto zero_null_path = null_tree.get_hash_path(0);
         rollup.old_null_paths.push_back(zero_null_path);
+        if (indexed_null_tree) {
+            rollup.indexed_null_insertions.push_back(indexed_null_tree->insert(0));
+        }
     }
 
     return rollup;
@@ -2,5 +2,7 @@
 #include "create_rollup_tx.hpp"
 #include "rollup_circuit.hpp"
 #include "rollup_proof_data.hpp"
+#include "rollup_proof_view.hpp"
 #include "rollup_tx.hpp"
+#include "validate.hpp"
 #include "verify.hpp"
\ No newline at end of file
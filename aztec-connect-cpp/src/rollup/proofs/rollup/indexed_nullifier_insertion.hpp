@@ -0,0 +1,37 @@
+#pragma once
+#include <ecc/curves/bn254/fr.hpp>
+#include <stdlib/merkle_tree/hash_path.hpp>
+
+namespace rollup {
+namespace proofs {
+namespace rollup {
+
+using namespace barretenberg;
+using namespace plonk::stdlib::merkle_tree;
+
+/**
+ * Witness for inserting one nullifier into the indexed nullifier tree.
+ * The low leaf is the leaf with the largest value below the nullifier. It is rewritten to point at the new leaf,
+ * which is then written into the empty slot at `new_leaf_index`, inheriting the low leaf's old successor.
+ * A zero nullifier (padding) uses the sentinel leaf 0 as its low leaf and leaves the tree unchanged.
+ */
+struct indexed_nullifier_insertion {
+    fr low_leaf_value;
+    uint32_t low_leaf_next_index;
+    fr low_leaf_next_value;
+    uint32_t low_leaf_index;
+    fr_hash_path low_leaf_path;
+
+    uint32_t new_leaf_index;
+    fr_hash_path new_leaf_path;
+
+    // Root after the low leaf is updated, and after the new leaf is inserted.
+    fr low_updated_root;
+    fr new_root;
+
+    bool operator==(indexed_nullifier_insertion const&) const = default;
+};
+
+} // namespace rollup
+} // namespace proofs
+} // namespace rollup
@@ -6,9 +6,13 @@
 #include "../notes/circuit/claim/index.hpp"
 #include <stdlib/merkle_tree/index.hpp>
 #include <stdlib/hash/sha256/sha256.hpp>
+#include <stdlib/hash/pedersen/pedersen.hpp>
 #include <common/map.hpp>
 #include <common/container.hpp>
+#include <optional>
 #include "../notes/constants.hpp"
+#include "../circuit_types.hpp"
+#include "../gate_profiler.hpp"
 
 // #pragma GCC diagnostic ignored "-Wunused-variable"
 // #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -16,7 +20,7 @@ namespace rollup {
 namespace proofs {
 namespace rollup {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace plonk::stdlib::recursion;
 using namespace plonk::stdlib::merkle_tree;
 using namespace notes;
@@ -28,6 +32,7 @@ field_ct check_nullifiers_inserted(Composer& composer,
                                    field_ct latest_null_root,
                                    std::vector<field_ct> const& new_null_indicies)
 {
+    gate_scope scope(composer, __FUNCTION__);
     for (size_t i = 0; i < new_null_indicies.size(); ++i) {
         auto is_real = num_txs > uint32_ct(&composer, i / 2) && new_null_indicies[i] != 0;
 
@@ -48,20 +53,141 @@ field_ct check_nullifiers_inserted(Composer& composer,
     return latest_null_root;
 }
 
+namespace {
+// A field element as its 128 bit low and 126 bit high limbs, so it can be compared as an integer.
+struct field_limbs {
+    field_ct lo;
+    field_ct hi;
+};
+
+/**
+ * Asserts a < b as integers, if `enabled`.
+ * b - a - 1 is computed limbwise, the prover supplying the borrow from the high limb. Both limbs of the difference
+ * being in range means it was non negative.
+ */
+void assert_less_than(
+    Composer& composer, field_limbs const& a, field_limbs const& b, bool_ct const& enabled, std::string const& msg)
+{
+    const auto shift = field_ct(&composer, fr(uint256_t(1) << 128));
+    const bool borrow_native = uint256_t(b.lo.get_value()) < uint256_t(a.lo.get_value()) + 1;
+    const auto borrow = field_ct(bool_ct(witness_ct(&composer, borrow_native)));
+
+    const auto lo_diff = (b.lo - a.lo - 1 + borrow * shift) * enabled;
+    const auto hi_diff = (b.hi - a.hi - borrow) * enabled;
+    lo_diff.create_range_constraint(128, msg);
+    hi_diff.create_range_constraint(126, msg);
+}
+
+// Splits `value` into limbs, checking the split is the canonical one (i.e. is less than the modulus).
+field_limbs split_into_limbs(Composer& composer, field_ct const& value, std::string const& msg)
+{
+    const auto native = uint256_t(value.get_value());
+    const auto lo = field_ct(witness_ct(&composer, fr(native.slice(0, 128))));
+    const auto hi = field_ct(witness_ct(&composer, fr(native.slice(128, 256))));
+    lo.create_range_constraint(128, msg);
+    hi.create_range_constraint(126, msg);
+    (lo + hi * field_ct(&composer, fr(uint256_t(1) << 128))).assert_equal(value, msg);
+
+    const auto modulus = uint256_t(fr::modulus);
+    const auto modulus_limbs = field_limbs{ field_ct(&composer, fr(modulus.slice(0, 128))),
+                                            field_ct(&composer, fr(modulus.slice(128, 256))) };
+    assert_less_than(composer, { lo, hi }, modulus_limbs, bool_ct(&composer, true), msg);
+    return { lo, hi };
+}
+} // namespace
+
+/**
+ * Inserts the nullifiers into the indexed nullifier tree (see `world_state/indexed_tree.hpp`).
+ * For each nullifier, the low leaf must sort strictly below it, and its successor strictly above it (or be the end of
+ * the list). The low leaf is repointed at the new leaf, which is written into an empty slot.
+ * Emptiness of the slot is all we need of `new_leaf_index`; as no leaf hashes to 0, no leaf can be overwritten.
+ * Padding insertions leave the low leaf as it is and write 0 into the empty slot, so are noops.
+ */
+field_ct check_nullifiers_inserted_indexed(Composer& composer,
+                                           std::vector<indexed_nullifier_insertion> const& insertions,
+                                           uint32_ct const& num_txs,
+                                           field_ct latest_null_root,
+                                           std::vector<field_ct> const& new_nullifiers)
+{
+    gate_scope scope(composer, __FUNCTION__);
+    for (size_t i = 0; i < new_nullifiers.size(); ++i) {
+        auto const& insertion = insertions[i];
+        auto const& nullifier = new_nullifiers[i];
+        auto is_real = num_txs > uint32_ct(&composer, i / 2) && nullifier != 0;
+
+        const auto low_value = field_ct(witness_ct(&composer, insertion.low_leaf_value));
+        const auto low_next_index = field_ct(witness_ct(&composer, insertion.low_leaf_next_index));
+        const auto low_next_value = field_ct(witness_ct(&composer, insertion.low_leaf_next_value));
+        const auto low_index = field_ct(witness_ct(&composer, insertion.low_leaf_index));
+        const auto low_path = create_witness_hash_path(composer, insertion.low_leaf_path);
+        const auto new_index = field_ct(witness_ct(&composer, insertion.new_leaf_index));
+        const auto new_path = create_witness_hash_path(composer, insertion.new_leaf_path);
+        const auto low_updated_root = field_ct(witness_ct(&composer, insertion.low_updated_root));
+        const auto new_root = field_ct(witness_ct(&composer, insertion.new_root));
+
+        // Check the nullifier sorts between the low leaf and its successor.
+        const auto msg = format(__FUNCTION__, "_", i);
+        const auto nullifier_limbs = split_into_limbs(composer, nullifier, msg + "_nullifier");
+        assert_less_than(composer,
+                         split_into_limbs(composer, low_value, msg + "_low_value"),
+                         nullifier_limbs,
+                         is_real,
+                         msg + "_low_value_not_below_nullifier");
+        assert_less_than(composer,
+                         nullifier_limbs,
+                         split_into_limbs(composer, low_next_value, msg + "_low_next_value"),
+                         is_real && low_next_value != 0,
+                         msg + "_nullifier_not_below_next_value");
+
+        // Point the low leaf at the new leaf.
+        const auto low_leaf = pedersen::compress({ low_value, low_next_index, low_next_value },
+                                                 GeneratorIndex::INDEXED_NULLIFIER_LEAF);
+        const auto updated_low_leaf = pedersen::compress({ low_value, new_index, nullifier },
+                                                         GeneratorIndex::INDEXED_NULLIFIER_LEAF);
+        update_membership(low_updated_root,
+                          field_ct::conditional_assign(is_real, updated_low_leaf, low_leaf),
+                          latest_null_root,
+                          low_path,
+                          low_leaf,
+                          low_index.decompose_into_bits(INDEXED_NULL_TREE_DEPTH),
+                          msg + "_low_leaf");
+
+        // Write the new leaf into the empty slot.
+        const auto new_leaf = pedersen::compress({ nullifier, low_next_index, low_next_value },
+                                                 GeneratorIndex::INDEXED_NULLIFIER_LEAF);
+        update_membership(new_root,
+                          new_leaf * is_real,
+                          low_updated_root,
+                          new_path,
+                          field_ct(0),
+                          new_index.decompose_into_bits(INDEXED_NULL_TREE_DEPTH),
+                          msg + "_new_leaf");
+
+        latest_null_root = new_root;
+    }
+
+    return latest_null_root;
+}
+
 /**
  * Processes a defi deposit proof.
  * - We only process join split proofs with a proof_id == ProofIds::DEFI_DEPOSIT (otherwise noop).
  * - Ensure that the bridge_call_data matches one within the of set of bridge_call_datas.
  * - Accumulate the deposit value in relevant defi_deposit_sums slot. These later become public inputs.
  * - Modify the claim note commitment (output_note_1 commitment) to add the relevant interaction nonce to it.
+ *
+ * If `bridge_call_data_lookup` is given, the match and the deposit are added to it instead, and `defi_deposit_sums` is
+ * left alone.
  */
 auto process_defi_deposit(Composer& composer,
                           field_ct const& rollup_id,
                           std::vector<field_ct>& public_inputs,
                           std::vector<suint_ct> const& bridge_call_datas,
                           std::vector<suint_ct>& defi_deposit_sums,
-                          field_ct const& num_defi_interactions)
+                          field_ct const& num_defi_interactions,
+                          slot_lookup* bridge_call_data_lookup)
 {
+    gate_scope scope(composer, __FUNCTION__);
     field_ct defi_interaction_nonce = (rollup_id * NUM_BRIDGE_CALLS_PER_BLOCK);
 
     const auto proof_id = public_inputs[InnerProofFields::PROOF_ID];
@@ -78,24 +204,29 @@ auto process_defi_deposit(Composer& composer,
      * Then the defi_interaction_nonce = rollup_id * NUM_BRIDGE_CALLS_PER_BLOCK + k.
      */
     field_ct note_defi_interaction_nonce = defi_interaction_nonce;
-    field_ct num_matched(&composer, 0);
+    if (bridge_call_data_lookup) {
+        note_defi_interaction_nonce += bridge_call_data_lookup->add(
+            bridge_call_data.value, deposit_value.value, is_defi_deposit, "proof bridge call data");
+    } else {
+        field_ct num_matched(&composer, 0);
 
-    for (uint32_t k = 0; k < NUM_BRIDGE_CALLS_PER_BLOCK; k++) {
-        auto is_real = uint32_ct(k) < num_defi_interactions;
+        for (uint32_t k = 0; k < NUM_BRIDGE_CALLS_PER_BLOCK; k++) {
+            auto is_real = uint32_ct(k) < num_defi_interactions;
 
-        const auto matches = bridge_call_data == bridge_call_datas[k] && is_real;
-        num_matched += matches;
+            const auto matches = bridge_call_data == bridge_call_datas[k] && is_real;
+            num_matched += matches;
 
-        defi_deposit_sums[k] += deposit_value * is_defi_deposit * matches;
-        note_defi_interaction_nonce += (field_ct(&composer, k) * matches);
+            defi_deposit_sums[k] += deposit_value * is_defi_deposit * matches;
+            note_defi_interaction_nonce += (field_ct(&composer, k) * matches);
+        }
+
+        // Assert this proof matched a single bridge_call_data.
+        auto is_valid_bridge_call_data = num_matched == 1 || !is_defi_deposit;
+        is_valid_bridge_call_data.assert_equal(
+            true, format("proof bridge call data matched ", uint64_t(num_matched.get_value()), " times"));
     }
     note_defi_interaction_nonce *= is_defi_deposit;
 
-    // Assert this proof matched a single bridge_call_data.
-    auto is_valid_bridge_call_data = num_matched == 1 || !is_defi_deposit;
-    is_valid_bridge_call_data.assert_equal(
-        true, format("proof bridge call data matched ", uint64_t(num_matched.get_value()), " times"));
-
     // Compute claim fee which to be added to the claim note.
     const suint_ct tx_fee(public_inputs[InnerProofFields::TX_FEE], TX_FEE_BIT_LENGTH, "tx_fee");
     const suint_ct defi_deposit_fee = tx_fee / 2;
@@ -124,6 +255,71 @@ auto process_claims(std::vector<field_ct>& public_inputs, field_ct const& new_de
     valid.assert_equal(true, format("claim proof has unmatched defi root"));
 }
 
+/**
+ * Checks each value in use (non zero) is in the tree with the given root, and returns a lookup of the values, which
+ * txs can be matched against in place of a membership check of their own. Unused checks are padded with zero values.
+ */
+slot_lookup create_membership_lookup(Composer& composer,
+                                     field_ct const& root,
+                                     std::vector<fr> const& values,
+                                     std::vector<fr_hash_path> const& paths,
+                                     std::vector<uint32_t> const& indices,
+                                     size_t num_checks,
+                                     size_t depth,
+                                     std::string const& name)
+{
+    gate_scope scope(composer, __FUNCTION__);
+    std::vector<field_ct> slots;
+    std::vector<bool_ct> in_use;
+    const auto padding_path = fr_hash_path(depth, std::make_pair(fr(0), fr(0)));
+    for (size_t k = 0; k < num_checks; ++k) {
+        const bool has_value = k < values.size();
+        const auto value = field_ct(witness_ct(&composer, has_value ? values[k] : fr(0)));
+        const auto path = create_witness_hash_path(composer, has_value ? paths[k] : padding_path);
+        const auto index = field_ct(witness_ct(&composer, has_value ? indices[k] : 0));
+
+        const bool_ct is_used = value != 0;
+        const auto exists = check_membership(root, path, value, index.decompose_into_bits(depth));
+        is_used.must_imply(exists, format(name, " ", k, " must exist. Membership check failed for ", value));
+
+        slots.push_back(value);
+        in_use.push_back(is_used);
+    }
+    return slot_lookup(composer, slots, in_use);
+}
+
+/**
+ * Checks the commitment a tx at the start of a split chain propagates exists in the data tree, or, if
+ * `linked_commitment_lookup` is given, matches it to one of the rollup's linked commitment checks.
+ */
+void check_linked_commitment_exists(size_t i,
+                                    bool_ct const& start_of_subchain,
+                                    field_ct const& backward_link,
+                                    field_ct const& old_data_root,
+                                    std::vector<merkle_tree::hash_path> const& linked_commitment_paths,
+                                    std::vector<field_ct> const& linked_commitment_indices,
+                                    slot_lookup* linked_commitment_lookup)
+{
+    if (linked_commitment_lookup) {
+        linked_commitment_lookup->add(
+            backward_link, field_ct(0), start_of_subchain, format("tx ", i, "'s linked commitment"));
+        return;
+    }
+
+    const bool_ct linked_commitment_exists =
+        merkle_tree::check_membership(old_data_root,
+                                      linked_commitment_paths[i],
+                                      backward_link,
+                                      linked_commitment_indices[i].decompose_into_bits(DATA_TREE_DEPTH));
+
+    (start_of_subchain)
+        .must_imply(linked_commitment_exists,
+                    format("tx ",
+                           i,
+                           "'s linked commitment must exist. Membership check failed for backward_link ",
+                           backward_link));
+}
+
 /**
  * Check chained transaction inputs - called once per tx `i`.
  * - Look back over all earlier txs in the rollup for other txs in the chain.
@@ -139,7 +335,8 @@ void process_chained_txs(size_t const& i,
                          std::vector<std::vector<field_ct>> const& prev_txs_public_inputs,
                          field_ct const& old_data_root,
                          std::vector<merkle_tree::hash_path> const& linked_commitment_paths,
-                         std::vector<field_ct> const& linked_commitment_indices)
+                         std::vector<field_ct> const& linked_commitment_indices,
+                         slot_lookup* linked_commitment_lookup)
 {
     const field_ct backward_link = field_ct(public_inputs[InnerProofFields::BACKWARD_LINK]);
 
@@ -190,18 +387,13 @@ void process_chained_txs(size_t const& i,
     // middle_of_chain = "this tx is not the first tx of its chain to be included in this rollup"
     const bool_ct middle_of_chain = chaining && found_link_in_rollup;
 
-    const bool_ct linked_commitment_exists =
-        merkle_tree::check_membership(old_data_root,
-                                      linked_commitment_paths[i],
-                                      backward_link,
-                                      linked_commitment_indices[i].decompose_into_bits(DATA_TREE_DEPTH));
-
-    (start_of_subchain)
-        .must_imply(linked_commitment_exists,
-                    format("tx ",
-                           i,
-                           "'s linked commitment must exist. Membership check failed for backward_link ",
-                           backward_link));
+    check_linked_commitment_exists(i,
+                                   start_of_subchain,
+                                   backward_link,
+                                   old_data_root,
+                                   linked_commitment_paths,
+                                   linked_commitment_indices,
+                                   linked_commitment_lookup);
 
     field_ct attempting_to_propagate_output_index = field_ct::conditional_assign(
         is_propagating_prev_output1, 1, field_ct::conditional_assign(is_propagating_prev_output2, 2, 0));
@@ -217,8 +409,163 @@ void process_chained_txs(size_t const& i,
                            prev_allow_chain));
 }
 
+/**
+ * Performs the same checks as `process_chained_txs` for all txs at once, at a cost linear in the number of txs.
+ *
+ * Rather than searching all earlier txs in-circuit, the earlier tx (if any) whose output a tx's backward_link
+ * propagates is found natively, exactly as `process_chained_txs` would find it. Each such link is supplied as a
+ * witness (tx index, output number, output commitment, allow_chain), and is shown to be an entry of the table of all
+ * tx outputs with a logarithmic derivative argument:
+ *
+ *   sum_links 1 / (alpha - encode(link)) == sum_outputs multiplicity / (alpha - encode(output))
+ *
+ * The challenges alpha and beta are derived from one hash of every value the identity depends on. The tx public inputs
+ * are committed to by `seed`, except the first note commitments, which a defi deposit completes in this circuit, so
+ * only those and the link witnesses, range constrained and packed, are hashed with it.
+ */
+void process_chained_txs_multiset(Composer& composer,
+                                  std::vector<field_ct> const& seed,
+                                  std::vector<std::vector<field_ct>> const& txs_public_inputs,
+                                  std::vector<bool_ct> const& txs_is_real,
+                                  field_ct const& old_data_root,
+                                  std::vector<merkle_tree::hash_path> const& linked_commitment_paths,
+                                  std::vector<field_ct> const& linked_commitment_indices,
+                                  slot_lookup* linked_commitment_lookup)
+{
+    gate_scope scope(composer, __FUNCTION__);
+    const auto num_txs = txs_public_inputs.size();
+    const auto index_bit_length = static_cast<size_t>(numeric::get_msb(uint64_t(num_txs))) + 1;
+
+    auto output_commitment = [&](size_t j, size_t output) {
+        auto field = output == 1 ? InnerProofFields::NOTE_COMMITMENT1 : InnerProofFields::NOTE_COMMITMENT2;
+        return txs_public_inputs[j][field];
+    };
+
+    // Find each tx's link natively. As in `process_chained_txs`, the last matching earlier tx wins, and its first
+    // output is preferred over its second.
+    std::vector<bool_ct> found_link_in_rollup;
+    std::vector<field_ct> link_tx_index;
+    std::vector<bool_ct> link_is_output2;
+    std::vector<field_ct> link_allow_chain;
+    std::vector<uint64_t> num_links_to_output(num_txs * 2, 0);
+    for (size_t i = 0; i < num_txs; ++i) {
+        const auto backward_link = txs_public_inputs[i][InnerProofFields::BACKWARD_LINK].get_value();
+        bool found = false;
+        size_t tx_index = 0;
+        size_t output = 1;
+        if (backward_link != 0 && txs_is_real[i].get_value()) {
+            for (size_t j = 0; j < i; ++j) {
+                for (size_t k = 2; k >= 1; --k) {
+                    if (backward_link == output_commitment(j, k).get_value()) {
+                        found = true;
+                        tx_index = j;
+                        output = k;
+                    }
+                }
+            }
+        }
+        if (found) {
+            num_links_to_output[tx_index * 2 + output - 1]++;
+        }
+        const auto allow_chain = found ? txs_public_inputs[tx_index][InnerProofFields::ALLOW_CHAIN].get_value() : fr(0);
+
+        found_link_in_rollup.push_back(bool_ct(witness_ct(&composer, found)));
+        link_tx_index.push_back(field_ct(witness_ct(&composer, tx_index)));
+        link_is_output2.push_back(bool_ct(witness_ct(&composer, output == 2)));
+        link_allow_chain.push_back(field_ct(witness_ct(&composer, allow_chain)));
+    }
+    const auto multiplicities = map(num_links_to_output, [&](auto m) { return field_ct(witness_ct(&composer, m)); });
+
+    // Range constrain the witnesses, so they can be packed into the transcript. An output can only be linked to by the
+    // txs after it, so fewer than 2^index_bit_length times.
+    for (size_t i = 0; i < num_txs; ++i) {
+        link_tx_index[i].create_range_constraint(index_bit_length, format("tx ", i, " link index out of range"));
+        link_allow_chain[i].create_range_constraint(2, format("tx ", i, " link allow_chain out of range"));
+    }
+    for (auto const& multiplicity : multiplicities) {
+        multiplicity.create_range_constraint(index_bit_length, "chained tx link multiplicity out of range");
+    }
+
+    // Per tx checks.
+    for (size_t i = 0; i < num_txs; ++i) {
+        const auto& public_inputs = txs_public_inputs[i];
+        const field_ct backward_link = public_inputs[InnerProofFields::BACKWARD_LINK];
+        const bool_ct chaining = backward_link != 0;
+        const auto& found = found_link_in_rollup[i];
+
+        // Only a real tx can propagate an earlier output. Padded txs have a 0 backward_link.
+        found.must_imply(chaining && txs_is_real[i], format("tx ", i, " claims a link but is not chaining"));
+
+        // The linked tx must be an earlier one, i.e. 0 <= i - 1 - link_tx_index < 2^index_bit_length.
+        const auto distance = (field_ct(&composer, fr(i)) - 1 - link_tx_index[i]) * field_ct(found);
+        distance.create_range_constraint(index_bit_length, format("tx ", i, " links to a later tx"));
+
+        const bool_ct start_of_subchain = chaining && !found;
+        check_linked_commitment_exists(i,
+                                       start_of_subchain,
+                                       backward_link,
+                                       old_data_root,
+                                       linked_commitment_paths,
+                                       linked_commitment_indices,
+                                       linked_commitment_lookup);
+
+        // Note: prev_allow_chain = 3 => "both outputs of prev_tx may be propagated from"
+        const auto attempting_to_propagate_output_index = field_ct(link_is_output2[i]) + 1;
+        const auto& prev_allow_chain = link_allow_chain[i];
+        (found).must_imply(prev_allow_chain == attempting_to_propagate_output_index || prev_allow_chain == 3,
+                           format("tx ",
+                                  i,
+                                  " is not permitted to propagate output ",
+                                  attempting_to_propagate_output_index,
+                                  " of the prev tx. prev_allow_chain = ",
+                                  prev_allow_chain));
+    }
+
+    // Derive the challenges from everything the identity depends on.
+    const auto note_commitments1 = map(txs_public_inputs, [](auto const& public_inputs) {
+        return public_inputs[InnerProofFields::NOTE_COMMITMENT1];
+    });
+    const auto transcript_inputs =
+        join({ seed,
+               note_commitments1,
+               pack(&composer, map(found_link_in_rollup, [](auto const& f) { return field_ct(f); }), 1),
+               pack(&composer, link_tx_index, index_bit_length),
+               pack(&composer, map(link_is_output2, [](auto const& o) { return field_ct(o); }), 1),
+               pack(&composer, link_allow_chain, 2),
+               pack(&composer, multiplicities, index_bit_length) });
+    const auto alpha = hash_transcript(&composer, transcript_inputs, GeneratorIndex::ROLLUP_CHAINED_TXS_CHALLENGE);
+    const auto beta = pedersen::compress({ alpha }, GeneratorIndex::ROLLUP_CHAINED_TXS_CHALLENGE);
+
+    auto encode = [&](field_ct const& tx_index,
+                      field_ct const& output,
+                      field_ct const& commitment,
+                      field_ct const& allow_chain) {
+        return tx_index + beta * (output + beta * (commitment + beta * allow_chain));
+    };
+
+    field_ct links_sum(&composer, 0);
+    field_ct outputs_sum(&composer, 0);
+    for (size_t i = 0; i < num_txs; ++i) {
+        const auto link = encode(link_tx_index[i],
+                                 field_ct(link_is_output2[i]) + 1,
+                                 txs_public_inputs[i][InnerProofFields::BACKWARD_LINK],
+                                 link_allow_chain[i]);
+        links_sum += field_ct(found_link_in_rollup[i]) / (alpha - link);
+
+        for (size_t output = 1; output <= 2; ++output) {
+            const auto entry = encode(field_ct(&composer, fr(i)),
+                                      field_ct(&composer, fr(output)),
+                                      output_commitment(i, output),
+                                      txs_public_inputs[i][InnerProofFields::ALLOW_CHAIN]);
+            outputs_sum += multiplicities[i * 2 + output - 1] / (alpha - entry);
+        }
+    }
+    links_sum.assert_equal(outputs_sum, "chained tx links are not outputs of earlier txs");
+}
+
 /**
  * Accumulate tx fees from each inner proof depending on the type of proof.
+ * If `asset_id_lookup` is given, a fee whose asset id is in the rollup's asset ids is added to it instead.
  */
 void accumulate_tx_fees(Composer& composer,
                         std::vector<suint_ct>& total_tx_fees,
@@ -227,8 +574,17 @@ void accumulate_tx_fees(Composer& composer,
                         suint_ct const& tx_fee,
                         std::vector<field_ct> const& asset_ids,
                         field_ct const& num_asset_ids,
-                        bool_ct const& is_real)
+                        bool_ct const& is_real,
+                        slot_lookup* asset_id_lookup)
 {
+    gate_scope scope(composer, __FUNCTION__);
+    if (asset_id_lookup) {
+        // Asset ids are distinct, so a tx matches at most one. Txs in non-fee paying assets match none.
+        const auto is_fee_asset = asset_id_lookup->contains(asset_id);
+        asset_id_lookup->add(asset_id, tx_fee.value, is_fee_asset, "proof asset id");
+        return;
+    }
+
     const auto is_account = proof_id == field_ct(ProofIds::ACCOUNT);
 
     // Accumulate tx_fee for each asset_id. Note that tx_fee = 0 for padding proofs.
@@ -251,7 +607,11 @@ void accumulate_tx_fees(Composer& composer,
 recursion_output<bn254> rollup_circuit(Composer& composer,
                                        rollup_tx const& rollup,
                                        std::vector<std::shared_ptr<waffle::verification_key>> const& verification_keys,
-                                       size_t max_num_txs)
+                                       size_t max_num_txs,
+                                       ChainingCheck chaining_check,
+                                       NullifierTree nullifier_tree,
+                                       SlotMatching slot_matching,
+                                       MembershipChecks membership_checks)
 {
     // Compute a constant witness of the next power of 2 > max_num_txs.
     const auto floor_rollup_size = 1UL << numeric::get_msb(max_num_txs);
@@ -269,21 +629,54 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
     const auto new_data_root = field_ct(witness_ct(&composer, rollup.new_data_root));
     const auto old_data_path = create_witness_hash_path(composer, rollup.old_data_path);
 
-    const auto linked_commitment_paths =
-        map(rollup.linked_commitment_paths, [&](auto& p) { return create_witness_hash_path(composer, p); });
-    const auto linked_commitment_indices =
-        map(rollup.linked_commitment_indices, [&](auto& i) { return field_ct(witness_ct(&composer, i)); });
+    // With deduplicated membership checks, the per tx paths are not needed.
+    std::vector<merkle_tree::hash_path> linked_commitment_paths;
+    std::vector<field_ct> linked_commitment_indices;
+    std::optional<slot_lookup> linked_commitment_lookup;
+    if (membership_checks.num_linked_commitments == 0) {
+        linked_commitment_paths =
+            map(rollup.linked_commitment_paths, [&](auto& p) { return create_witness_hash_path(composer, p); });
+        linked_commitment_indices =
+            map(rollup.linked_commitment_indices, [&](auto& i) { return field_ct(witness_ct(&composer, i)); });
+    } else {
+        linked_commitment_lookup.emplace(create_membership_lookup(composer,
+                                                                  old_data_root,
+                                                                  rollup.distinct_linked_commitments,
+                                                                  rollup.distinct_linked_commitment_paths,
+                                                                  rollup.distinct_linked_commitment_indices,
+                                                                  membership_checks.num_linked_commitments,
+                                                                  DATA_TREE_DEPTH,
+                                                                  "linked commitment"));
+    }
 
-    const auto old_null_root = field_ct(witness_ct(&composer, rollup.old_null_root));
-    const auto new_null_roots = map(rollup.new_null_roots, [&](auto& r) { return field_ct(witness_ct(&composer, r)); });
-    const auto old_null_paths =
-        map(rollup.old_null_paths, [&](auto& p) { return create_witness_hash_path(composer, p); });
+    const bool indexed_nullifiers = nullifier_tree == NullifierTree::INDEXED;
+    const auto old_null_root =
+        field_ct(witness_ct(&composer, indexed_nullifiers ? rollup.old_indexed_null_root : rollup.old_null_root));
+    std::vector<field_ct> new_null_roots;
+    std::vector<merkle_tree::hash_path> old_null_paths;
+    if (!indexed_nullifiers) {
+        new_null_roots = map(rollup.new_null_roots, [&](auto& r) { return field_ct(witness_ct(&composer, r)); });
+        old_null_paths = map(rollup.old_null_paths, [&](auto& p) { return create_witness_hash_path(composer, p); });
+    }
 
     const auto data_roots_root = field_ct(witness_ct(&composer, rollup.data_roots_root));
-    const auto data_roots_paths =
-        map(rollup.data_roots_paths, [&](auto& p) { return create_witness_hash_path(composer, p); });
-    const auto data_root_indicies =
-        map(rollup.data_roots_indicies, [&](auto& i) { return field_ct(witness_ct(&composer, i)); });
+    std::vector<merkle_tree::hash_path> data_roots_paths;
+    std::vector<field_ct> data_root_indicies;
+    std::optional<slot_lookup> data_root_lookup;
+    if (membership_checks.num_data_roots == 0) {
+        data_roots_paths = map(rollup.data_roots_paths, [&](auto& p) { return create_witness_hash_path(composer, p); });
+        data_root_indicies =
+            map(rollup.data_roots_indicies, [&](auto& i) { return field_ct(witness_ct(&composer, i)); });
+    } else {
+        data_root_lookup.emplace(create_membership_lookup(composer,
+                                                          data_roots_root,
+                                                          rollup.distinct_data_roots,
+                                                          rollup.distinct_data_roots_paths,
+                                                          rollup.distinct_data_roots_indicies,
+                                                          membership_checks.num_data_roots,
+                                                          ROOT_TREE_DEPTH,
+                                                          "data root"));
+    }
 
     const auto new_defi_root = field_ct(witness_ct(&composer, rollup.new_defi_root));
     const auto num_defi_interactions = field_ct(witness_ct(&composer, rollup.num_defi_interactions));
@@ -295,19 +688,33 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
     const auto num_asset_ids = field_ct(witness_ct(&composer, rollup.num_asset_ids));
     auto asset_ids = map(rollup.asset_ids, [&](auto& aid) { return field_ct(witness_ct(&composer, aid)); });
     // Zero any input bridge_call_datas that are outside scope, and check in scope bridge_call_datas are not zero.
+    std::vector<bool_ct> bridge_call_datas_in_scope;
     for (uint32_t i = 0; i < NUM_BRIDGE_CALLS_PER_BLOCK; i++) {
         auto in_scope = uint32_ct(i) < num_defi_interactions;
         bridge_call_datas[i] *= in_scope;
         auto valid = !in_scope || bridge_call_datas[i] != 0;
         valid.assert_equal(true, "bridge_call_data out of scope");
+        bridge_call_datas_in_scope.push_back(in_scope);
     }
 
     // Input asset_ids that are outside scope are set to 2^{30} (NUM_MAX_ASSETS).
+    std::vector<bool_ct> asset_ids_in_scope;
     for (uint32_t i = 0; i < NUM_ASSETS; i++) {
         auto in_scope = uint32_ct(i) < num_asset_ids;
         asset_ids[i] = field_ct::conditional_assign(in_scope, asset_ids[i], field_ct(MAX_NUM_ASSETS));
         auto valid = !in_scope || asset_ids[i] != field_ct(MAX_NUM_ASSETS);
         valid.assert_equal(true, "asset_id out of scope");
+        asset_ids_in_scope.push_back(in_scope);
+    }
+
+    std::optional<slot_lookup> bridge_call_data_lookup;
+    std::optional<slot_lookup> asset_id_lookup;
+    if (slot_matching == SlotMatching::LOOKUP) {
+        bridge_call_data_lookup.emplace(
+            composer, map(bridge_call_datas, [](auto const& b) { return b.value; }), bridge_call_datas_in_scope);
+        bridge_call_data_lookup->assert_in_use_slots_distinct("bridge call datas are not distinct");
+        asset_id_lookup.emplace(composer, asset_ids, asset_ids_in_scope);
+        asset_id_lookup->assert_in_use_slots_distinct("asset ids are not distinct");
     }
 
     // Loop accumulators.
@@ -320,6 +727,7 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
     // All public inputs of the inner txs (including public inputs which will not be made public by this rollup
     // circuit):
     std::vector<std::vector<field_ct>> prev_txs_public_inputs;
+    std::vector<bool_ct> txs_is_real;
     auto total_tx_fees = std::vector<suint_ct>(NUM_ASSETS, suint_ct::create_constant_witness(&composer, 0));
     std::vector<suint_ct> defi_deposit_sums(NUM_BRIDGE_CALLS_PER_BLOCK,
                                             suint_ct::create_constant_witness(&composer, 0));
@@ -332,12 +740,15 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
         recursive_verification_key->validate_key_is_in_set(verification_keys);
 
         // Verify the inner proof.
-        recursion_output =
-            verify_proof<bn254, recursive_turbo_verifier_settings<bn254>>(&composer,
-                                                                          recursive_verification_key,
-                                                                          recursive_manifest,
-                                                                          waffle::plonk_proof{ rollup.txs[i] },
-                                                                          recursion_output);
+        {
+            gate_scope scope(composer, "verify_proof");
+            recursion_output =
+                verify_proof<bn254, recursive_inner_verifier_settings<bn254>>(&composer,
+                                                                              recursive_verification_key,
+                                                                              recursive_manifest,
+                                                                              waffle::plonk_proof{ rollup.txs[i] },
+                                                                              recursion_output);
+        }
 
         auto is_real = num_txs > uint32_ct(&composer, i);
         auto& public_inputs = recursion_output.public_inputs;
@@ -347,8 +758,13 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
             public_inputs[j] *= is_real;
         }
 
-        auto tx_fee = process_defi_deposit(
-            composer, rollup_id, public_inputs, bridge_call_datas, defi_deposit_sums, num_defi_interactions);
+        auto tx_fee = process_defi_deposit(composer,
+                                           rollup_id,
+                                           public_inputs,
+                                           bridge_call_datas,
+                                           defi_deposit_sums,
+                                           num_defi_interactions,
+                                           bridge_call_data_lookup ? &*bridge_call_data_lookup : nullptr);
 
         process_claims(public_inputs, new_defi_root);
 
@@ -356,13 +772,17 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
         // `process_defi_deposit()` & `process_claims()` functions, but before `process_chained_txs`.
         propagated_tx_public_inputs.push_back(slice(public_inputs, 0, PropagatedInnerProofFields::NUM_FIELDS));
 
-        process_chained_txs(i,
-                            is_real,
-                            public_inputs,
-                            prev_txs_public_inputs,
-                            old_data_root,
-                            linked_commitment_paths,
-                            linked_commitment_indices);
+        if (chaining_check == ChainingCheck::QUADRATIC) {
+            gate_scope scope(composer, "process_chained_txs");
+            process_chained_txs(i,
+                                is_real,
+                                public_inputs,
+                                prev_txs_public_inputs,
+                                old_data_root,
+                                linked_commitment_paths,
+                                linked_commitment_indices,
+                                linked_commitment_lookup ? &*linked_commitment_lookup : nullptr);
+        }
 
         // Add this proof's data values to the list.
         new_data_values.push_back(public_inputs[InnerProofFields::NOTE_COMMITMENT1]);
@@ -374,31 +794,87 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
 
         // Check this proof's data root exists in the data root tree (unless a padding entry).
         auto data_root = public_inputs[InnerProofFields::MERKLE_ROOT];
-        bool_ct data_root_exists =
-            data_root != 0 && check_membership(data_roots_root,
-                                               data_roots_paths[i],
-                                               data_root,
-                                               data_root_indicies[i].decompose_into_bits(ROOT_TREE_DEPTH));
-        is_real.assert_equal(data_root_exists, format("data_root_for_proof_", i));
+        if (data_root_lookup) {
+            // Zero is never an in use slot, so a real tx can't match with a zero data root.
+            data_root_lookup->add(data_root, field_ct(0), is_real, format("data_root_for_proof_", i));
+        } else {
+            gate_scope scope(composer, "check_data_root_membership");
+            bool_ct data_root_exists =
+                data_root != 0 && check_membership(data_roots_root,
+                                                   data_roots_paths[i],
+                                                   data_root,
+                                                   data_root_indicies[i].decompose_into_bits(ROOT_TREE_DEPTH));
+            is_real.assert_equal(data_root_exists, format("data_root_for_proof_", i));
+        }
 
         // Accumulate tx fee.
         auto proof_id = public_inputs[InnerProofFields::PROOF_ID];
         auto asset_id = public_inputs[InnerProofFields::TX_FEE_ASSET_ID];
-        accumulate_tx_fees(composer, total_tx_fees, proof_id, asset_id, tx_fee, asset_ids, num_asset_ids, is_real);
+        accumulate_tx_fees(composer,
+                           total_tx_fees,
+                           proof_id,
+                           asset_id,
+                           tx_fee,
+                           asset_ids,
+                           num_asset_ids,
+                           is_real,
+                           asset_id_lookup ? &*asset_id_lookup : nullptr);
 
         prev_txs_public_inputs.push_back(public_inputs);
+        txs_is_real.push_back(is_real);
+    }
+
+    // Every lookup value and amount is read from the inner proofs, whose public inputs the recursion output commits to.
+    // Whether a tx is padding depends on num_txs.
+    auto seed = recursion_output_seed(recursion_output);
+    seed.push_back(field_ct(num_txs));
+
+    if (chaining_check == ChainingCheck::MULTISET) {
+        process_chained_txs_multiset(composer,
+                                     seed,
+                                     prev_txs_public_inputs,
+                                     txs_is_real,
+                                     old_data_root,
+                                     linked_commitment_paths,
+                                     linked_commitment_indices,
+                                     linked_commitment_lookup ? &*linked_commitment_lookup : nullptr);
+    }
+    if (data_root_lookup) {
+        data_root_lookup->finalise(seed, "proof data roots do not match the data root checks");
+    }
+    if (linked_commitment_lookup) {
+        linked_commitment_lookup->finalise(seed, "linked commitments do not match the linked commitment checks");
+    }
+
+    auto total_tx_fee_values = map(total_tx_fees, [](auto const& f) { return f.value; });
+    auto defi_deposit_sum_values = map(defi_deposit_sums, [](auto const& d) { return d.value; });
+    if (slot_matching == SlotMatching::LOOKUP) {
+        defi_deposit_sum_values =
+            bridge_call_data_lookup->finalise(seed, "proof bridge call datas do not match the bridge call datas");
+        total_tx_fee_values = asset_id_lookup->finalise(seed, "proof asset ids do not match the asset ids");
     }
 
     new_data_values.resize(rollup_size_pow2_ * 2, fr(0));
-    batch_update_membership(new_data_root, old_data_root, old_data_path, new_data_values, data_start_index.value);
+    {
+        gate_scope scope(composer, "batch_update_membership");
+        batch_update_membership(new_data_root, old_data_root, old_data_path, new_data_values, data_start_index.value);
+    }
 
     auto new_null_root =
-        check_nullifiers_inserted(composer, new_null_roots, old_null_paths, num_txs, old_null_root, new_null_indicies);
+        indexed_nullifiers
+            ? check_nullifiers_inserted_indexed(
+                  composer, rollup.indexed_null_insertions, num_txs, old_null_root, new_null_indicies)
+            : check_nullifiers_inserted(
+                  composer, new_null_roots, old_null_paths, num_txs, old_null_root, new_null_indicies);
 
     // Compute hash of the tx public inputs. Used to reduce number of public inputs published in root rollup.
     auto sha_input = flatten(propagated_tx_public_inputs);
     sha_input.resize(rollup_size_pow2_ * PropagatedInnerProofFields::NUM_FIELDS, field_ct(0));
-    auto hash_output = stdlib::sha256_to_field(packed_byte_array_ct::from_field_element_vector(sha_input));
+    field_ct hash_output;
+    {
+        gate_scope scope(composer, "sha256_to_field");
+        hash_output = stdlib::sha256_to_field(packed_byte_array_ct::from_field_element_vector(sha_input));
+    }
 
     // Publish public inputs.
     rollup_id.set_public();
@@ -415,13 +891,13 @@ recursion_output<bn254> rollup_circuit(Composer& composer,
     for (size_t i = 0; i < NUM_BRIDGE_CALLS_PER_BLOCK; ++i) {
         bridge_call_datas[i].set_public();
     }
-    for (size_t i = 0; i < NUM_BRIDGE_CALLS_PER_BLOCK; ++i) {
-        defi_deposit_sums[i].set_public();
+    for (auto& defi_deposit_sum : defi_deposit_sum_values) {
+        defi_deposit_sum.set_public();
     }
     for (size_t i = 0; i < NUM_ASSETS; ++i) {
         asset_ids[i].set_public();
     }
-    for (auto total_tx_fee : total_tx_fees) {
+    for (auto& total_tx_fee : total_tx_fee_values) {
         total_tx_fee.set_public();
     }
     hash_output.set_public();
@@ -1,16 +1,55 @@
 #pragma once
 #include "rollup_tx.hpp"
+#include "slot_lookup.hpp"
+#include "../circuit_types.hpp"
 #include <stdlib/recursion/verifier/program_settings.hpp>
 #include <stdlib/recursion/verifier/verifier.hpp>
-#include <stdlib/types/turbo.hpp>
 
 namespace rollup {
 namespace proofs {
 namespace rollup {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace plonk::stdlib::recursion;
 
+/**
+ * How chained txs (txs whose backward_link is an output of an earlier tx in the same rollup) are checked.
+ * QUADRATIC compares every tx against every earlier tx. MULTISET has the prover point each tx at its link, and checks
+ * all the links at once with a multiset argument, so grows linearly with the number of txs.
+ * The two accept the same rollups, but produce different circuits and keys. QUADRATIC is the default: MULTISET's
+ * hashing and field inversions are a fixed cost per tx that only beats the comparisons it saves at large sizes.
+ */
+enum class ChainingCheck { QUADRATIC, MULTISET };
+
+/**
+ * Which nullifier tree the rollup inserts its nullifiers into.
+ * SPARSE is the 256 deep tree indexed by nullifier, as used by the rollup contract. INDEXED is the 32 deep sorted
+ * linked list tree in `world_state/indexed_tree.hpp`, which needs far fewer hashes per nullifier. The two publish
+ * different null roots, so INDEXED circuits are not accepted by the contract, and are only for measurement.
+ */
+enum class NullifierTree { SPARSE, INDEXED };
+
+/**
+ * How each tx's fee asset id and bridge call data are matched against the rollup's asset ids and bridge call datas.
+ * SCAN compares every tx with every slot. LOOKUP has the prover name each tx's slot, and checks the claims together
+ * with the lookup argument in `slot_lookup.hpp`, so costs a few gates per tx plus a fixed cost per rollup, and only
+ * pays off for larger rollups. LOOKUP also rejects repeated in scope asset ids or bridge call datas outright, where
+ * SCAN only rejects them once a tx matches one.
+ */
+enum class SlotMatching { SCAN, LOOKUP };
+
+/**
+ * How many membership checks the rollup makes of tx data roots in the root tree, and of linked commitments (the
+ * commitments propagated by txs at the start of a split chain) in the data tree. 0 checks each tx's value separately,
+ * as the rollup contract's circuits do. Otherwise each distinct value is checked once, in one of that many checks, and
+ * each tx's value is matched to its check with the lookup argument in `slot_lookup.hpp`. A rollup with more distinct
+ * values than checks cannot be proven.
+ */
+struct MembershipChecks {
+    size_t num_data_roots = 0;
+    size_t num_linked_commitments = 0;
+};
+
 field_ct check_nullifiers_inserted(Composer& composer,
                                    std::vector<field_ct> const& new_null_roots,
                                    std::vector<merkle_tree::hash_path> const& old_null_paths,
@@ -18,10 +57,20 @@ field_ct check_nullifiers_inserted(Composer& composer,
                                    field_ct latest_null_root,
                                    std::vector<field_ct> const& new_null_indicies);
 
+field_ct check_nullifiers_inserted_indexed(Composer& composer,
+                                           std::vector<indexed_nullifier_insertion> const& insertions,
+                                           uint32_ct const& num_txs,
+                                           field_ct latest_null_root,
+                                           std::vector<field_ct> const& new_nullifiers);
+
 recursion_output<bn254> rollup_circuit(Composer& composer,
                                        rollup_tx const& proofs,
                                        std::vector<std::shared_ptr<waffle::verification_key>> const& verification_keys,
-                                       size_t rollup_size);
+                                       size_t rollup_size,
+                                       ChainingCheck chaining_check = ChainingCheck::QUADRATIC,
+                                       NullifierTree nullifier_tree = NullifierTree::SPARSE,
+                                       SlotMatching slot_matching = SlotMatching::SCAN,
+                                       MembershipChecks membership_checks = {});
 
 } // namespace rollup
 } // namespace proofs
@@ -2,9 +2,12 @@
 #include "../notes/native/index.hpp"
 #include "../../fixtures/test_context.hpp"
 #include "../../fixtures/compute_or_load_fixture.hpp"
+#include "../../fixtures/tx_mix_generator.hpp"
 #include "../join_split/create_noop_join_split_proof.hpp"
+#include "../gate_profiler.hpp"
 #include <common/test.hpp>
 #include <common/map.hpp>
+#include <common/container.hpp>
 
 namespace rollup {
 namespace proofs {
@@ -228,6 +231,36 @@ TEST_F(rollup_tests, test_1_proof_in_1_rollup)
     EXPECT_TRUE(result.logic_verified);
 }
 
+TEST_F(rollup_tests, test_gate_profiler_attributes_scopes)
+{
+    context.append_account_notes();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof = context.create_join_split_proof({ 2, 3 }, { 100, 50 }, { 70, 80 });
+    auto rollup = create_rollup_tx(context.world_state, 1, { join_split_proof });
+
+    gate_profiler profiler("rollup_1");
+    auto result = verify_logic(rollup, rollup_1_keyless);
+    EXPECT_TRUE(result.logic_verified);
+    profiler.finish(rollup_1_keyless.num_gates, 0);
+
+    auto const& children = profiler.root().children;
+    auto verify_proof =
+        std::find_if(children.begin(), children.end(), [](auto const& c) { return c->name == "verify_proof"; });
+    ASSERT_NE(verify_proof, children.end());
+    EXPECT_EQ((*verify_proof)->calls, 1UL);
+    EXPECT_GT((*verify_proof)->gates, 0UL);
+    EXPECT_GT((*verify_proof)->variables, 0UL);
+
+    size_t scoped_gates = 0;
+    for (auto const& c : children) {
+        scoped_gates += c->gates;
+    }
+    EXPECT_LE(scoped_gates, rollup_1_keyless.num_gates);
+    EXPECT_NE(profiler.folded().find("rollup_1;verify_proof "), std::string::npos);
+    EXPECT_NE(profiler.report().find("verify_proof x1: "), std::string::npos);
+}
+
 TEST_F(rollup_tests, test_1_proof_with_old_root_in_1_rollup)
 {
     size_t rollup_size = 1;
@@ -950,6 +983,295 @@ TEST_F(rollup_tests, test_chain_off_both_output_notes_and_consume_within_rollup_
     EXPECT_TRUE(result.logic_verified);
 }
 
+TEST_F(rollup_tests, test_multiset_chaining_check_with_gaps)
+{
+    size_t rollup_size = 8;
+
+    // As test_chain_off_both_output_notes_and_consume_within_rollup_with_gaps, with the multiset chaining check.
+    context.append_value_notes({ 100, 50, 75, 200, 300, 400, 500, 600 });
+    context.start_next_root_rollup();
+
+    auto tx1 = context.js_tx_factory.create_join_split_tx({ 0 }, { 100 }, { 70, 30 });
+    tx1.allow_chain = 3;
+    auto join_split_proof1 = create_js_proof(tx1);
+
+    auto tx2 = context.js_tx_factory.create_join_split_tx({ 8, 1 }, { 70, 50 }, { 120, 0 });
+    tx2.input_note[0] = tx1.output_note[0];
+    tx2.backward_link = tx2.input_note[0].commit();
+    auto join_split_proof2 = create_js_proof(tx2);
+
+    auto tx3 = context.js_tx_factory.create_join_split_tx({ 2, 9 }, { 75, 30 }, { 0, 105 });
+    tx3.input_note[1] = tx1.output_note[1];
+    tx3.backward_link = tx3.input_note[1].commit();
+    auto join_split_proof3 = create_js_proof(tx3);
+
+    auto tx4 = context.js_tx_factory.create_join_split_tx({ 3, 4 }, { 200, 300 }, { 20, 480 });
+    auto join_split_proof4 = create_js_proof(tx4);
+
+    auto tx5 = context.js_tx_factory.create_join_split_tx({ 5, 6 }, { 400, 500 }, { 1, 899 });
+    auto join_split_proof5 = create_js_proof(tx5);
+
+    auto rollup = create_rollup_tx(
+        context.world_state,
+        rollup_size,
+        { join_split_proof1, join_split_proof4, join_split_proof2, join_split_proof5, join_split_proof3 });
+
+    auto cd = rollup_5_keyless;
+    cd.chaining_check = ChainingCheck::MULTISET;
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_TRUE(result.logic_verified);
+}
+
+TEST_F(rollup_tests, test_multiset_chaining_check_disallowed_note_fails)
+{
+    size_t rollup_size = 2;
+
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+
+    auto tx1 = context.js_tx_factory.create_join_split_tx({ 0 }, { 100 }, { 70, 30 });
+    tx1.allow_chain = 2;
+    auto join_split_proof1 = create_js_proof(tx1);
+
+    auto tx2 = context.js_tx_factory.create_join_split_tx({ 0, 1 }, { 70, 50 }, { 120, 0 });
+    tx2.input_note[0] = tx1.output_note[0];
+    tx2.backward_link = tx1.output_note[0].commit();
+    auto join_split_proof2 = create_js_proof(tx2);
+
+    auto rollup = create_rollup_tx(context.world_state, rollup_size, { join_split_proof1, join_split_proof2 });
+
+    auto cd = rollup_2_keyless;
+    cd.chaining_check = ChainingCheck::MULTISET;
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_FALSE(result.logic_verified);
+    EXPECT_NE(result.err.find("is not permitted to propagate output"), std::string::npos);
+}
+
+TEST_F(rollup_tests, test_indexed_nullifier_tree)
+{
+    size_t rollup_size = 4;
+
+    context.world_state.enable_indexed_null_tree();
+    context.append_account_notes();
+    context.append_value_notes({ 0, 0, 100, 50, 80, 60 });
+    context.start_next_root_rollup();
+    auto join_split_proof1 = context.create_join_split_proof({ 4, 5 }, { 100, 50 }, { 70, 80 });
+    auto join_split_proof2 = context.create_join_split_proof({ 6, 7 }, { 80, 60 }, { 70, 70 });
+    auto account_proof = context.create_migrate_account_proof();
+
+    auto old_root = context.world_state.indexed_null_tree->root();
+    auto rollup = create_rollup_tx(
+        context.world_state, rollup_size, { join_split_proof1, account_proof, join_split_proof2 });
+
+    auto cd = rollup_4_keyless;
+    cd.nullifier_tree = NullifierTree::INDEXED;
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_TRUE(result.logic_verified);
+    auto rollup_data = rollup_proof_data(result.public_inputs);
+    EXPECT_EQ(rollup_data.old_null_root, old_root);
+    EXPECT_EQ(rollup_data.new_null_root, context.world_state.indexed_null_tree->root());
+}
+
+// Padding after real insertions must prove against the sentinel leaf as updated by them, not as first inserted.
+TEST_F(rollup_tests, test_indexed_nullifier_tree_noop_after_insertion)
+{
+    size_t rollup_size = 2;
+
+    context.world_state.enable_indexed_null_tree();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof = context.create_join_split_proof({ 0, 1 }, { 100, 50 }, { 70, 80 });
+
+    auto& indexed_null_tree = *context.world_state.indexed_null_tree;
+    auto rollup = create_rollup_tx(context.world_state, rollup_size, { join_split_proof });
+    auto const& noop = rollup.indexed_null_insertions.back();
+    EXPECT_EQ(indexed_null_tree.size(), 3UL);
+    EXPECT_NE(noop.low_leaf_next_value, fr(0));
+    EXPECT_EQ(noop.new_root, indexed_null_tree.root());
+
+    auto cd = rollup_2_keyless;
+    cd.nullifier_tree = NullifierTree::INDEXED;
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_TRUE(result.logic_verified);
+    auto rollup_data = rollup_proof_data(result.public_inputs);
+    EXPECT_EQ(rollup_data.new_null_root, indexed_null_tree.root());
+}
+
+TEST_F(rollup_tests, test_indexed_nullifier_tree_reuse_spent_note_fails)
+{
+    size_t rollup_size = 1;
+
+    context.world_state.enable_indexed_null_tree();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof = context.create_join_split_proof({ 0, 1 }, { 100, 50 }, { 70, 80 });
+    inner_proof_data inner_proof_data(join_split_proof);
+    context.world_state.nullify(inner_proof_data.nullifier1);
+
+    auto rollup = create_rollup_tx(context.world_state, rollup_size, { join_split_proof });
+    auto cd = rollup_1_keyless;
+    cd.nullifier_tree = NullifierTree::INDEXED;
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_FALSE(result.logic_verified);
+    EXPECT_EQ(result.err, "check_nullifiers_inserted_indexed_0_nullifier_not_below_next_value");
+}
+
+TEST_F(rollup_tests, test_lookup_slot_matching_matches_scan)
+{
+    auto tx = create_tx_with_3_defi_include_non_fee_asset();
+    auto result = verify_logic(tx, rollup_4_keyless);
+    ASSERT_TRUE(result.logic_verified);
+
+    auto cd = rollup_4_keyless;
+    cd.slot_matching = SlotMatching::LOOKUP;
+    auto lookup_result = verify_logic(tx, cd);
+    ASSERT_TRUE(lookup_result.logic_verified);
+
+    // Same fee and deposit sums, and same interaction nonces in the claim notes.
+    EXPECT_EQ(lookup_result.public_inputs, result.public_inputs);
+}
+
+TEST_F(rollup_tests, test_lookup_slot_matching_costs_fewer_gates_per_tx)
+{
+    // The lookup argument has a fixed cost per rollup, so compare the gates each adds for 2 more txs.
+    auto gates_for_2_more_txs = [&](SlotMatching slot_matching) {
+        auto cd_2 = rollup_2_keyless;
+        auto cd_4 = rollup_4_keyless;
+        cd_2.slot_matching = slot_matching;
+        cd_4.slot_matching = slot_matching;
+        auto rollup_2 = create_empty_rollup(context.world_state);
+        auto rollup_4 = create_empty_rollup(context.world_state);
+        auto result_2 = verify_logic(rollup_2, cd_2);
+        auto result_4 = verify_logic(rollup_4, cd_4);
+        EXPECT_TRUE(result_2.logic_verified);
+        EXPECT_TRUE(result_4.logic_verified);
+        return result_4.number_of_gates - result_2.number_of_gates;
+    };
+
+    auto scan_gates = gates_for_2_more_txs(SlotMatching::SCAN);
+    auto lookup_gates = gates_for_2_more_txs(SlotMatching::LOOKUP);
+    info("gates for 2 more txs: scan ", scan_gates, ", lookup ", lookup_gates);
+    EXPECT_LT(lookup_gates, scan_gates);
+}
+
+TEST_F(rollup_tests, test_lookup_slot_matching_asset_id_repeated_fails)
+{
+    auto tx = create_tx_with_3_defi();
+    tx.asset_ids.push_back(tx.asset_ids[0]);
+    auto cd = rollup_4_keyless;
+    cd.slot_matching = SlotMatching::LOOKUP;
+    auto result = verify_logic(tx, cd);
+
+    ASSERT_FALSE(result.logic_verified);
+    EXPECT_EQ(result.err, "asset ids are not distinct");
+}
+
+TEST_F(rollup_tests, test_lookup_slot_matching_bridge_call_data_unmatched_fails)
+{
+    auto tx = create_tx_with_1_defi();
+    tx.bridge_call_datas[0] = { 1, 2, 0, 0 };
+    auto cd = rollup_1_keyless;
+    cd.slot_matching = SlotMatching::LOOKUP;
+    auto result = verify_logic(tx, cd);
+
+    ASSERT_FALSE(result.logic_verified);
+    EXPECT_NE(result.err.find("matched no slot"), std::string::npos);
+}
+
+TEST_F(rollup_tests, test_membership_checks_match_per_tx_checks)
+{
+    auto tx = create_tx_with_3_defi();
+    auto result = verify_logic(tx, rollup_4_keyless);
+    ASSERT_TRUE(result.logic_verified);
+
+    // All three txs share a data root, so one data root check suffices.
+    auto cd = rollup_4_keyless;
+    cd.membership_checks = { 1, 1 };
+    auto deduplicated_result = verify_logic(tx, cd);
+    ASSERT_TRUE(deduplicated_result.logic_verified);
+
+    EXPECT_EQ(deduplicated_result.public_inputs, result.public_inputs);
+    info("gates: per tx checks ", result.number_of_gates, ", deduplicated ", deduplicated_result.number_of_gates);
+    EXPECT_LT(deduplicated_result.number_of_gates, result.number_of_gates);
+}
+
+TEST_F(rollup_tests, test_membership_checks_with_linked_commitment_path)
+{
+    // As test_gap_in_chain_spanning_rollups_with_linked_commitment_path, with deduplicated membership checks.
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    context.append_value_notes({ 70, 30, 15, 35 });
+    context.start_next_root_rollup();
+
+    auto tx2 = context.js_tx_factory.create_join_split_tx({ 0 }, { 70 }, { 10, 60 });
+    notes::native::value::value_note linked_note = {
+        70, 0, 0, context.user.owner.public_key, context.user.note_secret, 0, 2
+    };
+    tx2.input_note[0] = linked_note;
+    tx2.backward_link = linked_note.commit();
+    auto join_split_proof2 = create_js_proof(tx2);
+
+    auto rollup = create_rollup_tx(context.world_state, 4, { join_split_proof2 }, {}, { 0 }, {}, { 2 });
+    EXPECT_EQ(rollup.distinct_linked_commitments.size(), 1UL);
+    auto cd = rollup_4_keyless;
+    cd.membership_checks = { 2, 2 };
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_TRUE(result.logic_verified);
+}
+
+TEST_F(rollup_tests, test_membership_checks_linked_commitment_without_path_fails)
+{
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+
+    auto tx1 = context.js_tx_factory.create_join_split_tx({ 0 }, { 100 }, { 70, 30 });
+    tx1.allow_chain = 1;
+    context.append_value_notes({ 70, 30, 15, 35 });
+
+    auto tx2 = context.js_tx_factory.create_join_split_tx({ 0 }, { 70 }, { 10, 60 });
+    tx2.input_note[0] = tx1.output_note[0];
+    tx2.backward_link = tx2.input_note[0].commit();
+    auto join_split_proof2 = create_js_proof(tx2);
+
+    auto rollup = create_rollup_tx(context.world_state, 2, { join_split_proof2 });
+    auto cd = rollup_2_keyless;
+    cd.membership_checks = { 1, 1 };
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_FALSE(result.logic_verified);
+    EXPECT_NE(result.err.find("Membership check failed"), std::string::npos);
+}
+
+TEST_F(rollup_tests, test_membership_checks_too_few_data_root_checks_fails)
+{
+    // Two txs referencing the roots at index 1 and 2.
+    context.append_account_notes();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof1 = context.create_join_split_proof({ 2, 3 }, { 100, 50 }, { 70, 80 });
+    context.append_value_notes({ 30, 40 });
+    context.start_next_root_rollup();
+    auto join_split_proof2 = context.create_join_split_proof({ 4, 5 }, { 30, 40 }, { 50, 20 });
+
+    auto rollup =
+        create_rollup_tx(context.world_state, 2, { join_split_proof1, join_split_proof2 }, {}, { 0 }, { 1, 2 });
+    ASSERT_TRUE(verify_logic(rollup, rollup_2_keyless).logic_verified);
+    ASSERT_EQ(rollup.distinct_data_roots.size(), 2UL);
+    auto cd = rollup_2_keyless;
+    cd.membership_checks = { 1, 0 };
+    auto result = verify_logic(rollup, cd);
+
+    EXPECT_FALSE(result.logic_verified);
+    EXPECT_NE(result.err.find("data_root_for_proof_1"), std::string::npos);
+    EXPECT_NE(result.err.find("matched no slot"), std::string::npos);
+}
+
 // Rollups of size 3.
 TEST_F(rollup_tests, test_1_proof_in_3_rollup)
 {
@@ -1331,6 +1653,195 @@ TEST_F(rollup_tests, test_defi_claim_proof_has_valid_defi_root)
     EXPECT_FALSE(result2.logic_verified);
 }
 
+TEST_F(rollup_tests, test_tx_mix_rollups)
+{
+    fixtures::tx_mix mix;
+    mix.num_asset_ids = 2;
+    mix.num_bridge_call_datas = 3;
+    mix.notes_per_asset = 4;
+    mix.defi_deposit_weight = 40;
+    mix.chain_ratio = 0.5;
+    fixtures::tx_mix_generator generator(context, mix);
+
+    // The second block claims the first's defi deposits, drawn among its other txs, and spends the notes it output.
+    size_t first_block_defi_deposits = 0;
+    for (size_t block = 0; block < 2; ++block) {
+        auto rollups = generator.create_rollup_txs(4, { 4, 3 });
+        for (auto& rollup : rollups) {
+            EXPECT_TRUE(verify_logic(rollup, rollup_4_keyless).logic_verified);
+        }
+        // The world state doesn't depend on the inner rollup proofs.
+        generator.create_root_rollup_tx({});
+        first_block_defi_deposits = block == 0 ? generator.counts().defi_deposits : first_block_defi_deposits;
+    }
+
+    auto const& counts = generator.counts();
+    EXPECT_LE(counts.claims, first_block_defi_deposits);
+    EXPECT_EQ(counts.deposits + counts.sends + counts.withdraws + counts.defi_deposits + counts.claims +
+                  counts.accounts,
+              14U);
+}
+
+// Native validation tests.
+TEST_F(rollup_tests, test_validate_matches_verify_logic)
+{
+    auto tx = create_tx_with_3_defi();
+
+    auto validated = validate(tx, rollup_4_keyless);
+    ASSERT_TRUE(validated.valid);
+
+    auto result = verify_logic(tx, rollup_4_keyless);
+    ASSERT_TRUE(result.logic_verified);
+
+    // The circuit's public inputs additionally end in the recursion output limbs.
+    ASSERT_EQ(validated.public_inputs.size() + 16, result.public_inputs.size());
+    EXPECT_EQ(validated.public_inputs, slice(result.public_inputs, 0, validated.public_inputs.size()));
+}
+
+TEST_F(rollup_tests, test_validate_unpadded_matches_padded)
+{
+    auto tx = create_tx_with_3_defi();
+    auto padded_tx = tx;
+    pad_rollup_tx(padded_tx, rollup_4_keyless.num_txs, rollup_4_keyless.join_split_circuit_data.padding_proof);
+
+    auto validated = validate(tx, rollup_4_keyless, false);
+    auto validated_padded = validate_rollup_tx(padded_tx, rollup_4_keyless.verification_keys, 4, false);
+    ASSERT_TRUE(validated.valid);
+    ASSERT_TRUE(validated_padded.valid);
+    EXPECT_EQ(validated.public_inputs, validated_padded.public_inputs);
+
+    // A tx can only be read as padded when a padding proof is given.
+    EXPECT_EQ(validate_rollup_tx(tx, rollup_4_keyless.verification_keys, 4, false).err, "rollup tx is not padded");
+}
+
+// The in scope bridge call datas and asset ids are those recorded before padding, not every padded entry.
+TEST_F(rollup_tests, test_validate_already_padded_tx)
+{
+    auto tx = create_tx_with_3_defi();
+    auto padded_tx = tx;
+    pad_rollup_tx(padded_tx, rollup_4_keyless.num_txs, rollup_4_keyless.join_split_circuit_data.padding_proof);
+
+    auto validated = validate(tx, rollup_4_keyless, false);
+    auto validated_padded = validate(padded_tx, rollup_4_keyless, false);
+    ASSERT_TRUE(validated_padded.valid);
+    EXPECT_EQ(validated.public_inputs, validated_padded.public_inputs);
+}
+
+TEST_F(rollup_tests, test_validate_indexed_nullifier_tree_matches_verify_logic)
+{
+    context.world_state.enable_indexed_null_tree();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof = context.create_join_split_proof({ 0, 1 }, { 100, 50 }, { 70, 80 });
+    auto rollup = create_rollup_tx(context.world_state, 2, { join_split_proof });
+
+    auto cd = rollup_2_keyless;
+    cd.nullifier_tree = NullifierTree::INDEXED;
+    auto validated = validate(rollup, cd, false);
+    ASSERT_TRUE(validated.valid);
+
+    auto result = verify_logic(rollup, cd);
+    ASSERT_TRUE(result.logic_verified);
+    EXPECT_EQ(validated.public_inputs, slice(result.public_inputs, 0, validated.public_inputs.size()));
+}
+
+TEST_F(rollup_tests, test_validate_indexed_nullifier_tree_reuse_spent_note_fails)
+{
+    context.world_state.enable_indexed_null_tree();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof = context.create_join_split_proof({ 0, 1 }, { 100, 50 }, { 70, 80 });
+    inner_proof_data inner_proof_data(join_split_proof);
+    context.world_state.nullify(inner_proof_data.nullifier1);
+    auto rollup = create_rollup_tx(context.world_state, 1, { join_split_proof });
+
+    auto cd = rollup_1_keyless;
+    cd.nullifier_tree = NullifierTree::INDEXED;
+    auto result = validate(rollup, cd, false);
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.err, "check_nullifiers_inserted_indexed_0_nullifier_not_below_next_value");
+}
+
+TEST_F(rollup_tests, test_validate_lookup_slot_matching_repeated_asset_id_fails)
+{
+    auto tx = create_tx_with_3_defi();
+    tx.asset_ids.push_back(tx.asset_ids[0]);
+    tx.num_asset_ids = tx.asset_ids.size();
+
+    EXPECT_EQ(validate(tx, rollup_4_keyless, false).err, "proof asset id matched 2 times");
+    auto cd = rollup_4_keyless;
+    cd.slot_matching = SlotMatching::LOOKUP;
+    EXPECT_EQ(validate(tx, cd, false).err, "asset ids are not distinct");
+}
+
+TEST_F(rollup_tests, test_validate_data_root_index_out_of_range_fails)
+{
+    auto tx = create_tx_with_1_defi();
+    tx.data_roots_indicies[0] = 1U << ROOT_TREE_DEPTH;
+
+    auto result = validate(tx, rollup_1_keyless, false);
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.err, "tx 0's data root index out of range");
+}
+
+TEST_F(rollup_tests, test_validate_membership_checks_rejected)
+{
+    auto tx = create_tx_with_1_defi();
+    auto cd = rollup_1_keyless;
+    cd.membership_checks = { .num_data_roots = 1, .num_linked_commitments = 1 };
+
+    EXPECT_EQ(validate(tx, cd, false).err, "membership checks are not validated natively");
+}
+
+TEST_F(rollup_tests, test_validate_invalid_old_null_root_fails)
+{
+    context.append_account_notes();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof = context.create_join_split_proof({ 2, 3 }, { 100, 50 }, { 70, 80 });
+    auto rollup = create_rollup_tx(context.world_state, 1, { join_split_proof });
+
+    rollup.old_null_root = fr::random_element();
+
+    auto result = validate(rollup, rollup_1_keyless);
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.err, "check_nullifiers_inserted_0_old_value");
+}
+
+TEST_F(rollup_tests, test_validate_incorrect_data_start_index_fails)
+{
+    context.append_account_notes();
+    context.append_value_notes({ 100, 50 });
+    context.start_next_root_rollup();
+    auto join_split_proof = context.create_join_split_proof({ 2, 3 }, { 100, 50 }, { 70, 80 });
+    auto rollup = create_rollup_tx(context.world_state, 1, { join_split_proof });
+
+    rollup.data_start_index = 0;
+
+    auto result = validate(rollup, rollup_1_keyless);
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.err, "batch_update_membership_old_subtree");
+}
+
+TEST_F(rollup_tests, test_validate_defi_bridge_call_data_unmatched_fails)
+{
+    auto tx = create_tx_with_1_defi();
+    tx.bridge_call_datas[0] = { 1, 2, 0, 0 };
+
+    auto result = validate(tx, rollup_1_keyless);
+    EXPECT_FALSE(result.valid);
+}
+
+TEST_F(rollup_tests, test_validate_corrupt_inner_proof_fails)
+{
+    auto tx = create_tx_with_1_defi();
+    tx.txs[0].back() ^= 1;
+
+    auto result = validate(tx, rollup_1_keyless);
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.err, "inner proof 0 failed verification");
+}
+
 } // namespace rollup
 } // namespace proofs
 } // namespace rollup
\ No newline at end of file
@@ -1,12 +1,12 @@
 #pragma once
-#include <stdlib/types/turbo.hpp>
+#include "../circuit_types.hpp"
 #include "../../constants.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace rollup {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 namespace RollupProofFields {
 enum {
@@ -0,0 +1,176 @@
+#pragma once
+#include "rollup_proof_data.hpp"
+#include <common/serialize.hpp>
+#include <iterator>
+
+namespace rollup {
+namespace proofs {
+namespace rollup {
+
+/**
+ * A non-owning view over one propagated tx record (PropagatedInnerProofFields::NUM_FIELDS fields).
+ * These records appear in the public inputs of a tx rollup proof, and in root rollup broadcast data.
+ */
+struct propagated_inner_proof_view {
+    static constexpr size_t SIZE = PropagatedInnerProofFields::NUM_FIELDS * 32;
+
+    uint8_t const* data;
+
+    uint256_t proof_id() const { return read<uint256_t>(PropagatedInnerProofFields::PROOF_ID); }
+    fr note_commitment1() const { return read<fr>(PropagatedInnerProofFields::NOTE_COMMITMENT1); }
+    fr note_commitment2() const { return read<fr>(PropagatedInnerProofFields::NOTE_COMMITMENT2); }
+    uint256_t nullifier1() const { return read<uint256_t>(PropagatedInnerProofFields::NULLIFIER1); }
+    uint256_t nullifier2() const { return read<uint256_t>(PropagatedInnerProofFields::NULLIFIER2); }
+    uint256_t public_value() const { return read<uint256_t>(PropagatedInnerProofFields::PUBLIC_VALUE); }
+    fr public_owner() const { return read<fr>(PropagatedInnerProofFields::PUBLIC_OWNER); }
+    uint256_t asset_id() const { return read<uint256_t>(PropagatedInnerProofFields::PUBLIC_ASSET_ID); }
+
+    operator propagated_inner_proof_data() const
+    {
+        return { proof_id(),   note_commitment1(), note_commitment2(), nullifier1(),
+                 nullifier2(), public_value(),     public_owner(),     asset_id() };
+    }
+
+  private:
+    template <typename T> T read(size_t field) const { return from_buffer<T>(data + field * 32); }
+};
+
+/**
+ * Random access iterator over contiguous propagated tx records.
+ */
+class propagated_inner_proof_iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = propagated_inner_proof_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = propagated_inner_proof_view;
+
+    propagated_inner_proof_iterator()
+        : ptr_(nullptr)
+    {}
+    explicit propagated_inner_proof_iterator(uint8_t const* ptr)
+        : ptr_(ptr)
+    {}
+
+    propagated_inner_proof_view operator*() const { return { ptr_ }; }
+    propagated_inner_proof_view operator[](difference_type n) const { return { ptr_ + n * stride }; }
+
+    propagated_inner_proof_iterator& operator++()
+    {
+        ptr_ += stride;
+        return *this;
+    }
+    propagated_inner_proof_iterator operator++(int)
+    {
+        auto tmp = *this;
+        ptr_ += stride;
+        return tmp;
+    }
+    propagated_inner_proof_iterator& operator--()
+    {
+        ptr_ -= stride;
+        return *this;
+    }
+    propagated_inner_proof_iterator operator--(int)
+    {
+        auto tmp = *this;
+        ptr_ -= stride;
+        return tmp;
+    }
+    propagated_inner_proof_iterator& operator+=(difference_type n)
+    {
+        ptr_ += n * stride;
+        return *this;
+    }
+    propagated_inner_proof_iterator& operator-=(difference_type n)
+    {
+        ptr_ -= n * stride;
+        return *this;
+    }
+    propagated_inner_proof_iterator operator+(difference_type n) const
+    {
+        return propagated_inner_proof_iterator(ptr_ + n * stride);
+    }
+    propagated_inner_proof_iterator operator-(difference_type n) const
+    {
+        return propagated_inner_proof_iterator(ptr_ - n * stride);
+    }
+    difference_type operator-(propagated_inner_proof_iterator const& other) const
+    {
+        return (ptr_ - other.ptr_) / stride;
+    }
+
+    auto operator<=>(propagated_inner_proof_iterator const& other) const = default;
+
+  private:
+    static constexpr difference_type stride = propagated_inner_proof_view::SIZE;
+    uint8_t const* ptr_;
+};
+
+/**
+ * A range of `num` contiguous propagated tx records starting at `data`.
+ */
+struct propagated_inner_proofs_range {
+    uint8_t const* data;
+    size_t num;
+
+    propagated_inner_proof_iterator begin() const { return propagated_inner_proof_iterator(data); }
+    propagated_inner_proof_iterator end() const
+    {
+        return propagated_inner_proof_iterator(data + num * propagated_inner_proof_view::SIZE);
+    }
+    size_t size() const { return num; }
+    propagated_inner_proof_view operator[](size_t i) const { return { data + i * propagated_inner_proof_view::SIZE }; }
+};
+
+/**
+ * A non-owning view over the public inputs at the head of a tx rollup proof buffer, laid out as per
+ * RollupProofOffsets. Unlike `rollup_proof_data`, fields are deserialized on access and the inner proof records are
+ * exposed as a range of views rather than copied into a vector.
+ * The underlying proof buffer must outlive the view.
+ */
+struct rollup_proof_view {
+    uint8_t const* data;
+
+    rollup_proof_view(uint8_t const* proof_data)
+        : data(proof_data)
+    {}
+    rollup_proof_view(std::vector<uint8_t> const& proof_data)
+        : data(proof_data.data())
+    {}
+    // A view must not be taken over a temporary buffer.
+    rollup_proof_view(std::vector<uint8_t>&&) = delete;
+
+    uint32_t rollup_id() const { return read<uint32_t>(RollupProofOffsets::ROLLUP_ID + 28); }
+    uint32_t rollup_size() const { return read<uint32_t>(RollupProofOffsets::ROLLUP_SIZE + 28); }
+    uint32_t data_start_index() const { return read<uint32_t>(RollupProofOffsets::DATA_START_INDEX + 28); }
+    fr old_data_root() const { return read<fr>(RollupProofOffsets::OLD_DATA_ROOT); }
+    fr new_data_root() const { return read<fr>(RollupProofOffsets::NEW_DATA_ROOT); }
+    fr old_null_root() const { return read<fr>(RollupProofOffsets::OLD_NULL_ROOT); }
+    fr new_null_root() const { return read<fr>(RollupProofOffsets::NEW_NULL_ROOT); }
+    fr old_data_roots_root() const { return read<fr>(RollupProofOffsets::OLD_DATA_ROOTS_ROOT); }
+    fr new_data_roots_root() const { return read<fr>(RollupProofOffsets::NEW_DATA_ROOTS_ROOT); }
+    fr old_defi_root() const { return read<fr>(RollupProofOffsets::OLD_DEFI_ROOT); }
+    fr new_defi_root() const { return read<fr>(RollupProofOffsets::NEW_DEFI_ROOT); }
+    uint256_t bridge_call_data(size_t i) const
+    {
+        return read<uint256_t>(RollupProofOffsets::DEFI_BRIDGE_CALL_DATAS + i * 32);
+    }
+    uint256_t deposit_sum(size_t i) const { return read<uint256_t>(RollupProofOffsets::DEFI_BRIDGE_DEPOSITS + i * 32); }
+    uint256_t asset_id(size_t i) const { return read<uint256_t>(RollupProofOffsets::ASSET_IDS + i * 32); }
+    uint256_t total_tx_fee(size_t i) const { return read<uint256_t>(RollupProofOffsets::TOTAL_TX_FEES + i * 32); }
+    fr input_hash() const { return read<fr>(RollupProofFields::INPUTS_HASH * 32); }
+
+    propagated_inner_proofs_range inner_proofs() const
+    {
+        return { data + RollupProofOffsets::INNER_PROOFS_DATA, rollup_size() };
+    }
+
+  private:
+    template <typename T> T read(size_t offset) const { return from_buffer<T>(data + offset); }
+};
+
+} // namespace rollup
+} // namespace proofs
+} // namespace rollup
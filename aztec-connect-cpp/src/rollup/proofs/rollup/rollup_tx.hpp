@@ -6,6 +6,7 @@
 #include <ecc/curves/bn254/fr.hpp>
 #include <sstream>
 #include <stdlib/merkle_tree/hash_path.hpp>
+#include "indexed_nullifier_insertion.hpp"
 
 namespace rollup {
 namespace proofs {
@@ -57,6 +58,21 @@ struct rollup_tx {
 
     // Not serialized or known about externally. Number of assets (< NUM_ASSETS) allowed in this rollup.
     size_t num_asset_ids;
+
+    // Not serialized or known about externally. Indexed nullifier tree insertion info, only used by circuits built
+    // with `NullifierTree::INDEXED`. One insertion per nullifier, followed by a noop insertion used for padding.
+    fr old_indexed_null_root;
+    std::vector<indexed_nullifier_insertion> indexed_null_insertions;
+
+    // Not serialized or known about externally. Deduplicated membership witnesses, only used by circuits built with
+    // `MembershipChecks`: each distinct data root of the txs, and each distinct commitment propagated by a tx at the
+    // start of a split chain, with the paths proving them.
+    std::vector<fr> distinct_data_roots;
+    std::vector<fr_hash_path> distinct_data_roots_paths;
+    std::vector<uint32_t> distinct_data_roots_indicies;
+    std::vector<fr> distinct_linked_commitments;
+    std::vector<fr_hash_path> distinct_linked_commitment_paths;
+    std::vector<uint32_t> distinct_linked_commitment_indices;
 };
 
 template <typename B> inline void read(B& buf, rollup_tx& tx)
@@ -85,6 +101,10 @@ template <typename B> inline void read(B& buf, rollup_tx& tx)
     read(buf, tx.new_defi_root);
     read(buf, tx.bridge_call_datas);
     read(buf, tx.asset_ids);
+
+    // The serialized tx is unpadded, so every bridge call data and asset id it holds is in scope.
+    tx.num_defi_interactions = tx.bridge_call_datas.size();
+    tx.num_asset_ids = tx.asset_ids.size();
 }
 
 template <typename B> inline void write(B& buf, rollup_tx const& tx)
@@ -0,0 +1,174 @@
+#include "slot_lookup.hpp"
+#include "../notes/constants.hpp"
+#include "../circuit_types.hpp"
+#include "../gate_profiler.hpp"
+#include <stdlib/hash/pedersen/pedersen.hpp>
+#include <common/map.hpp>
+#include <common/container.hpp>
+
+namespace rollup {
+namespace proofs {
+namespace rollup {
+
+using namespace ::rollup::proofs::circuit_types;
+using namespace notes;
+
+std::vector<field_ct> pack(Composer* composer, std::vector<field_ct> const& values, size_t bit_length)
+{
+    const size_t values_per_element = 252 / bit_length;
+    const field_ct shift(composer, uint256_t(1) << bit_length);
+    std::vector<field_ct> packed;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i % values_per_element == 0) {
+            packed.push_back(field_ct(composer, 0));
+        }
+        packed.back() = packed.back().madd(shift, values[i]);
+    }
+    return packed;
+}
+
+field_ct hash_transcript(Composer* composer, std::vector<field_ct> const& inputs, size_t hash_index)
+{
+    field_ct transcript(composer, 0);
+    for (size_t i = 0; i < inputs.size(); i += 7) {
+        std::vector<field_ct> chunk = { transcript };
+        chunk.insert(chunk.end(),
+                     inputs.begin() + static_cast<long>(i),
+                     inputs.begin() + static_cast<long>(std::min(i + 7, inputs.size())));
+        transcript = pedersen::compress(chunk, hash_index);
+    }
+    return transcript;
+}
+
+slot_lookup::slot_lookup(Composer& composer, std::vector<field_ct> const& slots, std::vector<bool_ct> const& in_use)
+    : composer_(&composer)
+    , slots_(slots)
+    , in_use_(in_use)
+    , index_bit_length_(static_cast<size_t>(numeric::get_msb(uint64_t(slots.size() - 1))) + 1)
+    , counts_(slots.size(), 0)
+    , sums_(slots.size(), 0)
+{
+    ASSERT(slots.size() == in_use.size() && !slots.empty());
+}
+
+void slot_lookup::assert_in_use_slots_distinct(std::string const& msg) const
+{
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        for (size_t j = i + 1; j < slots_.size(); ++j) {
+            auto distinct = !(in_use_[i] && in_use_[j]) || slots_[i] != slots_[j];
+            distinct.assert_equal(true, msg);
+        }
+    }
+}
+
+bool_ct slot_lookup::contains(field_ct const& value)
+{
+    if (vanishing_polynomial_.empty()) {
+        // Multiply out prod_k (in_use_k ? X - slot_k : 1), lowest degree coefficient first.
+        vanishing_polynomial_ = { field_ct(composer_, 1) };
+        for (size_t k = 0; k < slots_.size(); ++k) {
+            const field_ct x_coefficient(in_use_[k]);
+            const auto constant_coefficient = field_ct(composer_, 1) - x_coefficient * (slots_[k] + 1);
+            std::vector<field_ct> product(vanishing_polynomial_.size() + 1, field_ct(composer_, 0));
+            for (size_t j = 0; j < vanishing_polynomial_.size(); ++j) {
+                product[j] = constant_coefficient.madd(vanishing_polynomial_[j], product[j]);
+                product[j + 1] = x_coefficient.madd(vanishing_polynomial_[j], product[j + 1]);
+            }
+            vanishing_polynomial_ = product;
+        }
+    }
+
+    auto result = vanishing_polynomial_.back();
+    for (size_t j = vanishing_polynomial_.size() - 1; j > 0; --j) {
+        result = result.madd(value, vanishing_polynomial_[j - 1]);
+    }
+    return result.is_zero();
+}
+
+field_ct slot_lookup::add(field_ct const& value,
+                          field_ct const& amount,
+                          bool_ct const& is_lookup,
+                          std::string const& name)
+{
+    // Find the slot natively. The first in use slot holding the value is taken.
+    size_t index = 0;
+    if (is_lookup.get_value()) {
+        bool matched = false;
+        for (size_t k = 0; k < slots_.size() && !matched; ++k) {
+            if (in_use_[k].get_value() && slots_[k].get_value() == value.get_value()) {
+                index = k;
+                matched = true;
+            }
+        }
+        if (matched) {
+            counts_[index]++;
+            sums_[index] += amount.get_value();
+        } else if (first_unmatched_.empty()) {
+            first_unmatched_ = format(name, " ", value, " matched no slot");
+        }
+    }
+
+    const auto index_ct = field_ct(witness_ct(composer_, index));
+    index_ct.create_range_constraint(index_bit_length_, format(name, " slot index out of range"));
+    lookups_.push_back({ index_ct, value, amount, is_lookup });
+    return index_ct;
+}
+
+std::vector<field_ct> slot_lookup::finalise(std::vector<field_ct> const& seed, std::string const& msg)
+{
+    gate_scope scope(*composer_, "slot_lookup_finalise");
+    const auto counts = map(counts_, [&](auto count) {
+        auto count_ct = field_ct(witness_ct(composer_, count));
+        count_ct.create_range_constraint(32, msg);
+        return count_ct;
+    });
+    const auto sums = map(sums_, [&](auto const& sum) { return field_ct(witness_ct(composer_, sum)); });
+
+    // Only slots in use may be matched.
+    for (size_t k = 0; k < slots_.size(); ++k) {
+        (counts[k] * field_ct(!in_use_[k])).assert_is_zero(msg);
+    }
+
+    // Derive the challenges from everything the identity depends on.
+    const auto in_use = map(in_use_, [](auto const& u) { return field_ct(u); });
+    const auto indices = map(lookups_, [](auto const& l) { return l.index; });
+    const auto is_lookups = map(lookups_, [](auto const& l) { return field_ct(l.is_lookup); });
+    const auto transcript_inputs = join({ seed,
+                                          slots_,
+                                          pack(composer_, in_use, 1),
+                                          pack(composer_, counts, 32),
+                                          sums,
+                                          pack(composer_, indices, index_bit_length_),
+                                          pack(composer_, is_lookups, 1) });
+    const auto alpha = hash_transcript(composer_, transcript_inputs, GeneratorIndex::ROLLUP_SLOT_LOOKUP_CHALLENGE);
+    const auto beta = pedersen::compress({ alpha }, GeneratorIndex::ROLLUP_SLOT_LOOKUP_CHALLENGE);
+    const auto gamma = pedersen::compress({ beta }, GeneratorIndex::ROLLUP_SLOT_LOOKUP_CHALLENGE);
+
+    field_ct lookups_sum(composer_, 0);
+    for (auto const& l : lookups_) {
+        const auto entry = l.index + beta * l.value;
+        const auto weight = (l.amount * gamma + 1) * field_ct(l.is_lookup);
+        lookups_sum += weight / (alpha - entry);
+    }
+
+    field_ct slots_sum(composer_, 0);
+    for (size_t k = 0; k < slots_.size(); ++k) {
+        const auto entry = field_ct(composer_, fr(k)) + beta * slots_[k];
+        slots_sum += (counts[k] + gamma * sums[k]) / (alpha - entry);
+    }
+    lookups_sum.assert_equal(slots_sum, first_unmatched_.empty() ? msg : first_unmatched_);
+
+    return sums;
+}
+
+std::vector<field_ct> recursion_output_seed(recursion_output<bn254> const& output)
+{
+    return { output.P0.x.prime_basis_limb,
+             output.P0.y.prime_basis_limb,
+             output.P1.x.prime_basis_limb,
+             output.P1.y.prime_basis_limb };
+}
+
+} // namespace rollup
+} // namespace proofs
+} // namespace rollup
@@ -0,0 +1,80 @@
+#pragma once
+#include <stdlib/recursion/verifier/verifier.hpp>
+#include "../circuit_types.hpp"
+
+namespace rollup {
+namespace proofs {
+namespace rollup {
+
+using namespace ::rollup::proofs::circuit_types;
+using namespace plonk::stdlib::recursion;
+
+/**
+ * Matches values against a rollup's fixed list of slots (its asset ids or bridge call datas), and sums an amount into
+ * the slot each value matches.
+ *
+ * Rather than comparing each value with every slot, the prover names the slot each value matches, and all the claims
+ * are checked at once with a weighted logarithmic derivative argument:
+ *
+ *   sum_lookups (1 + gamma * amount) / (alpha - (slot + beta * value))
+ *       == sum_slots (count + gamma * sum) / (alpha - (slot + beta * slot_value))
+ *
+ * A lookup then costs a few gates, however many slots there are. The slot counts and sums are witnesses, and only
+ * slots that are in use may be matched. The challenges are derived from a hash of `seed` and of every witness the
+ * identity depends on, including which lookups are made, so `seed` must commit to the values and amounts looked up.
+ *
+ * Two in use slots holding the same value would make a match ambiguous. Call `assert_in_use_slots_distinct` once,
+ * unless the slots are known to be distinct.
+ */
+class slot_lookup {
+  public:
+    slot_lookup(Composer& composer, std::vector<field_ct> const& slots, std::vector<bool_ct> const& in_use);
+
+    void assert_in_use_slots_distinct(std::string const& msg) const;
+
+    /**
+     * Whether `value` is held by an in use slot. Evaluates the polynomial vanishing on the in use slots, so costs a
+     * gate per slot. The polynomial is built on the first call.
+     */
+    bool_ct contains(field_ct const& value);
+
+    /**
+     * If `is_lookup`, `value` must be held by an in use slot, and `amount` is added to that slot's sum.
+     * Returns the index of the matched slot. Nothing is checked until `finalise`.
+     */
+    field_ct add(field_ct const& value, field_ct const& amount, bool_ct const& is_lookup, std::string const& name);
+
+    // Checks every lookup added, and returns the sum of each slot.
+    std::vector<field_ct> finalise(std::vector<field_ct> const& seed, std::string const& msg);
+
+  private:
+    struct lookup {
+        field_ct index;
+        field_ct value;
+        field_ct amount;
+        bool_ct is_lookup;
+    };
+
+    Composer* composer_;
+    std::vector<field_ct> slots_;
+    std::vector<bool_ct> in_use_;
+    size_t index_bit_length_;
+    std::vector<field_ct> vanishing_polynomial_;
+    std::vector<lookup> lookups_;
+    std::vector<uint64_t> counts_;
+    std::vector<fr> sums_;
+    std::string first_unmatched_;
+};
+
+// The coordinates of the aggregated pairing points, which commit to every public input of the verified proofs.
+std::vector<field_ct> recursion_output_seed(recursion_output<bn254> const& output);
+
+// Packs values below 2^bit_length into as few field elements as possible. The values must be range constrained.
+std::vector<field_ct> pack(Composer* composer, std::vector<field_ct> const& values, size_t bit_length);
+
+// Hashes `inputs` into a challenge, chaining a pedersen compression over every seven of them.
+field_ct hash_transcript(Composer* composer, std::vector<field_ct> const& inputs, size_t hash_index);
+
+} // namespace rollup
+} // namespace proofs
+} // namespace rollup
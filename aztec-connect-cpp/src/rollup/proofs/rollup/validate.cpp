@@ -0,0 +1,585 @@
+#include "validate.hpp"
+#include "create_rollup_tx.hpp"
+#include "rollup_proof_data.hpp"
+#include "../../constants.hpp"
+#include "../inner_proof_data/inner_proof_data.hpp"
+#include "../notes/native/claim/index.hpp"
+#include "../notes/constants.hpp"
+#include <common/thread.hpp>
+#include <common/timer.hpp>
+#include <crypto/sha256/sha256.hpp>
+#include <crypto/pedersen/pedersen.hpp>
+#include <plonk/proof_system/verifier/verifier.hpp>
+#include <stdlib/merkle_tree/hash.hpp>
+
+namespace rollup {
+namespace proofs {
+namespace rollup {
+
+using namespace barretenberg;
+using namespace plonk::stdlib::merkle_tree;
+
+namespace {
+
+/**
+ * Computes the root of the tree given by `path`, with `value` at `index`, starting `height` levels above the leaves.
+ * As in `update_membership`, only the siblings of the nodes along the path are taken from `path`.
+ */
+fr compute_root(fr_hash_path const& path, fr const& value, uint256_t const& index, size_t height = 0)
+{
+    auto current = value;
+    for (size_t i = height; i < path.size(); ++i) {
+        current =
+            index.get_bit(i) ? hash_pair_native(path[i].first, current) : hash_pair_native(current, path[i].second);
+    }
+    return current;
+}
+
+bool check_membership(fr const& root, fr_hash_path const& path, fr const& value, uint256_t const& index)
+{
+    return compute_root(path, value, index) == root;
+}
+
+bool fits(uint256_t const& value, size_t bit_length)
+{
+    return value.get_msb() < bit_length || value == 0;
+}
+
+// See `IndexedTree::hash_leaf`.
+fr hash_indexed_leaf(fr const& value, uint256_t const& next_index, fr const& next_value)
+{
+    return crypto::pedersen::compress_native({ value, fr(next_index), next_value },
+                                             notes::GeneratorIndex::INDEXED_NULLIFIER_LEAF);
+}
+
+// See `update_membership`.
+bool check_update(fr const& new_root,
+                  fr const& new_value,
+                  fr const& old_root,
+                  fr_hash_path const& path,
+                  fr const& old_value,
+                  uint256_t const& index)
+{
+    return check_membership(old_root, path, old_value, index) && check_membership(new_root, path, new_value, index);
+}
+
+template <typename T> bool has_repeats(std::vector<T> const& values, size_t num_in_scope)
+{
+    for (size_t i = 0; i < num_in_scope; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (values[i] == values[j]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Validates a padded rollup tx, or an unpadded one as if it were padded with `pad_rollup_tx`. Entries past the end of
+ * an unpadded tx's vectors are read as padding would have filled them, rather than copying the tx to pad it.
+ * The options are those of the circuit being validated for. `chaining_check` does not change which rollups are
+ * accepted. Membership checks are not replayed, so a circuit built with any is rejected outright.
+ */
+struct validator {
+    rollup_tx const& rollup;
+    std::vector<uint8_t> const& padding_proof;
+    std::vector<std::shared_ptr<waffle::verification_key>> const& verification_keys;
+    size_t max_num_txs;
+    ChainingCheck chaining_check;
+    NullifierTree nullifier_tree;
+    SlotMatching slot_matching;
+    MembershipChecks membership_checks;
+    std::string err;
+
+    bool fail(std::string const& msg)
+    {
+        err = msg;
+        return false;
+    }
+
+    std::vector<uint8_t> const& tx(size_t i) const { return i < rollup.txs.size() ? rollup.txs[i] : padding_proof; }
+
+    // Padding repeats the last entry.
+    template <typename T> static T const& padded(std::vector<T> const& entries, size_t i)
+    {
+        return i < entries.size() ? entries[i] : entries.back();
+    }
+
+    // Padding appends zeros.
+    template <typename T> static T padded_or_zero(std::vector<T> const& entries, size_t i)
+    {
+        return i < entries.size() ? entries[i] : T(0);
+    }
+
+    // Whether a vector is padded, or can be read as if it were. Only a tx given with a padding proof can be.
+    bool is_padded_to(size_t padded_size, size_t size, bool repeats_last) const
+    {
+        if (padding_proof.empty()) {
+            return size == padded_size;
+        }
+        return size == padded_size || (size < padded_size && (!repeats_last || size > 0));
+    }
+
+    validate_result run(bool verify_inner_proofs)
+    {
+        validate_result result;
+        if (validate(result.public_inputs) && (!verify_inner_proofs || this->verify_inner_proofs())) {
+            result.valid = true;
+        } else {
+            result.err = err;
+            result.public_inputs.clear();
+        }
+        return result;
+    }
+
+    bool verify_inner_proofs()
+    {
+        std::vector<uint8_t> verified(max_num_txs, 0);
+        parallel_for(max_num_txs, [&](size_t i) {
+            auto const& proof = tx(i);
+            auto proof_id = from_buffer<uint32_t>(proof, InnerProofOffsets::PROOF_ID + 28);
+            if (proof_id >= verification_keys.size()) {
+                return;
+            }
+            auto const& vk = verification_keys[proof_id];
+            UnrolledVerifier verifier(vk, Composer::create_unrolled_manifest(vk->num_public_inputs));
+            verified[i] = verifier.verify_proof(waffle::plonk_proof{ proof });
+        });
+        for (size_t i = 0; i < max_num_txs; ++i) {
+            if (!verified[i]) {
+                return fail(format("inner proof ", i, " failed verification"));
+            }
+        }
+        return true;
+    }
+
+    bool validate(std::vector<fr>& public_inputs)
+    {
+        const auto floor_rollup_size = 1UL << numeric::get_msb(max_num_txs);
+        const auto rollup_size_pow2 = floor_rollup_size << (max_num_txs != floor_rollup_size);
+        const auto rollup_id = rollup.rollup_id;
+        const auto num_txs = rollup.num_txs;
+        const auto num_defi_interactions = rollup.num_defi_interactions;
+        const auto num_asset_ids = rollup.num_asset_ids;
+        const bool indexed_nullifiers = nullifier_tree == NullifierTree::INDEXED;
+
+        if (membership_checks.num_data_roots || membership_checks.num_linked_commitments) {
+            return fail("membership checks are not validated natively");
+        }
+        if (!is_padded_to(max_num_txs, rollup.txs.size(), false) ||
+            !is_padded_to(max_num_txs, rollup.linked_commitment_paths.size(), false) ||
+            !is_padded_to(max_num_txs, rollup.linked_commitment_indices.size(), false) ||
+            !is_padded_to(max_num_txs, rollup.data_roots_paths.size(), true) ||
+            !is_padded_to(max_num_txs, rollup.data_roots_indicies.size(), false) ||
+            !is_padded_to(max_num_txs * 2, rollup.new_null_roots.size(), true) ||
+            !is_padded_to(max_num_txs * 2, rollup.old_null_paths.size(), true) ||
+            !is_padded_to(NUM_BRIDGE_CALLS_PER_BLOCK, rollup.bridge_call_datas.size(), false) ||
+            !is_padded_to(NUM_ASSETS, rollup.asset_ids.size(), false) ||
+            (indexed_nullifiers && !is_padded_to(max_num_txs * 2, rollup.indexed_null_insertions.size(), true))) {
+            return fail("rollup tx is not padded");
+        }
+        if (num_defi_interactions > rollup.bridge_call_datas.size() || num_asset_ids > rollup.asset_ids.size()) {
+            return fail("more bridge call datas or asset ids in scope than given");
+        }
+        if (!fits(num_txs, MAX_TXS_BIT_LENGTH) || num_txs > max_num_txs) {
+            return fail(format("num_txs ", num_txs, " out of range"));
+        }
+        if (!fits(rollup.data_start_index, DATA_TREE_DEPTH)) {
+            return fail("data_start_index out of range");
+        }
+
+        // Zero any input bridge_call_datas that are outside scope, and check in scope bridge_call_datas are not zero.
+        std::vector<uint256_t> bridge_call_datas(NUM_BRIDGE_CALLS_PER_BLOCK, 0);
+        for (size_t i = 0; i < NUM_BRIDGE_CALLS_PER_BLOCK; ++i) {
+            const auto bridge_call_data = padded_or_zero(rollup.bridge_call_datas, i);
+            if (!fits(bridge_call_data, DEFI_BRIDGE_CALL_DATA_BIT_LENGTH)) {
+                return fail("bridge_call_data out of range");
+            }
+            if (i < num_defi_interactions) {
+                if (bridge_call_data == 0) {
+                    return fail("bridge_call_data out of scope");
+                }
+                bridge_call_datas[i] = bridge_call_data;
+            }
+        }
+
+        // Input asset_ids that are outside scope are set to 2^{30} (NUM_MAX_ASSETS).
+        std::vector<uint256_t> asset_ids(NUM_ASSETS, MAX_NUM_ASSETS);
+        for (size_t i = 0; i < NUM_ASSETS && i < num_asset_ids; ++i) {
+            const auto asset_id = padded_or_zero(rollup.asset_ids, i);
+            if (asset_id == MAX_NUM_ASSETS) {
+                return fail("asset_id out of scope");
+            }
+            asset_ids[i] = asset_id;
+        }
+
+        if (slot_matching == SlotMatching::LOOKUP) {
+            if (has_repeats(bridge_call_datas, num_defi_interactions)) {
+                return fail("bridge call datas are not distinct");
+            }
+            if (has_repeats(asset_ids, num_asset_ids)) {
+                return fail("asset ids are not distinct");
+            }
+        }
+
+        std::vector<std::vector<fr>> txs_public_inputs;
+        std::vector<fr> new_data_values;
+        std::vector<uint256_t> new_null_indicies;
+        std::vector<uint256_t> total_tx_fees(NUM_ASSETS, 0);
+        std::vector<uint256_t> defi_deposit_sums(NUM_BRIDGE_CALLS_PER_BLOCK, 0);
+
+        for (size_t i = 0; i < max_num_txs; ++i) {
+            const bool is_real = num_txs > i;
+
+            if (!fits(padded_or_zero(rollup.linked_commitment_indices, i), DATA_TREE_DEPTH)) {
+                return fail(format("tx ", i, "'s linked commitment index out of range"));
+            }
+            if (!fits(padded_or_zero(rollup.data_roots_indicies, i), ROOT_TREE_DEPTH)) {
+                return fail(format("tx ", i, "'s data root index out of range"));
+            }
+
+            std::vector<fr> tx_public_inputs(InnerProofFields::NUM_FIELDS, 0);
+            if (is_real) {
+                auto ptr = tx(i).data();
+                for (auto& public_input : tx_public_inputs) {
+                    read(ptr, public_input);
+                }
+            }
+
+            if (!process_defi_deposit(i, rollup_id, tx_public_inputs, bridge_call_datas, defi_deposit_sums)) {
+                return false;
+            }
+            const uint256_t proof_id = tx_public_inputs[InnerProofFields::PROOF_ID];
+            const uint256_t tx_fee = tx_public_inputs[InnerProofFields::TX_FEE];
+            const auto net_tx_fee = proof_id == ProofIds::DEFI_DEPOSIT ? tx_fee >> 1 : tx_fee;
+
+            const auto defi_root = tx_public_inputs[InnerProofFields::DEFI_ROOT];
+            if (proof_id == ProofIds::DEFI_CLAIM && defi_root != rollup.new_defi_root) {
+                return fail("claim proof has unmatched defi root");
+            }
+
+            if (!process_chained_tx(i, is_real, tx_public_inputs, txs_public_inputs)) {
+                return false;
+            }
+
+            new_data_values.push_back(tx_public_inputs[InnerProofFields::NOTE_COMMITMENT1]);
+            new_data_values.push_back(tx_public_inputs[InnerProofFields::NOTE_COMMITMENT2]);
+            new_null_indicies.push_back(tx_public_inputs[InnerProofFields::NULLIFIER1]);
+            new_null_indicies.push_back(tx_public_inputs[InnerProofFields::NULLIFIER2]);
+
+            // Check this proof's data root exists in the data root tree (unless a padding entry).
+            const auto data_root = tx_public_inputs[InnerProofFields::MERKLE_ROOT];
+            const bool data_root_exists =
+                data_root != 0 && check_membership(rollup.data_roots_root,
+                                                   padded(rollup.data_roots_paths, i),
+                                                   data_root,
+                                                   padded_or_zero(rollup.data_roots_indicies, i));
+            if (is_real != data_root_exists) {
+                return fail(format("data_root_for_proof_", i));
+            }
+
+            // Accumulate tx fee.
+            const uint256_t asset_id = tx_public_inputs[InnerProofFields::TX_FEE_ASSET_ID];
+            size_t num_matched = 0;
+            for (size_t k = 0; k < NUM_ASSETS; ++k) {
+                if (k < num_asset_ids && asset_id == asset_ids[k]) {
+                    total_tx_fees[k] += net_tx_fee;
+                    ++num_matched;
+                }
+            }
+            if (is_real && num_matched > 1 && proof_id != ProofIds::ACCOUNT) {
+                return fail(format("proof asset id matched ", num_matched, " times"));
+            }
+
+            txs_public_inputs.push_back(tx_public_inputs);
+        }
+
+        if (!check_data_tree_update(rollup_size_pow2, new_data_values)) {
+            return false;
+        }
+        const auto old_null_root = indexed_nullifiers ? rollup.old_indexed_null_root : rollup.old_null_root;
+        fr new_null_root;
+        if (!(indexed_nullifiers ? check_nullifiers_inserted_indexed(new_null_indicies, new_null_root)
+                                 : check_nullifiers_inserted(new_null_indicies, new_null_root))) {
+            return false;
+        }
+
+        // Compute hash of the tx public inputs, as the circuit does.
+        std::vector<uint8_t> sha_input;
+        sha_input.reserve(rollup_size_pow2 * PropagatedInnerProofFields::NUM_FIELDS * 32);
+        for (auto const& tx_public_inputs : txs_public_inputs) {
+            for (size_t j = 0; j < PropagatedInnerProofFields::NUM_FIELDS; ++j) {
+                write(sha_input, tx_public_inputs[j]);
+            }
+        }
+        sha_input.resize(rollup_size_pow2 * PropagatedInnerProofFields::NUM_FIELDS * 32, 0);
+        const auto hash_output = sha256::sha256_to_field(sha_input);
+
+        // Public inputs, in the order `rollup_circuit` sets them.
+        public_inputs = { fr(rollup_id),
+                          fr(rollup_size_pow2),
+                          fr(rollup.data_start_index),
+                          rollup.old_data_root,
+                          rollup.new_data_root,
+                          old_null_root,
+                          new_null_root,
+                          rollup.data_roots_root,
+                          rollup.data_roots_root,
+                          fr(0), // old_defi_root
+                          rollup.new_defi_root };
+        public_inputs.insert(public_inputs.end(), bridge_call_datas.begin(), bridge_call_datas.end());
+        public_inputs.insert(public_inputs.end(), defi_deposit_sums.begin(), defi_deposit_sums.end());
+        public_inputs.insert(public_inputs.end(), asset_ids.begin(), asset_ids.end());
+        public_inputs.insert(public_inputs.end(), total_tx_fees.begin(), total_tx_fees.end());
+        public_inputs.push_back(hash_output);
+        for (auto const& tx_public_inputs : txs_public_inputs) {
+            public_inputs.insert(public_inputs.end(),
+                                 tx_public_inputs.begin(),
+                                 tx_public_inputs.begin() + PropagatedInnerProofFields::NUM_FIELDS);
+        }
+        public_inputs.resize(RollupProofFields::INNER_PROOFS_DATA +
+                                 rollup_size_pow2 * PropagatedInnerProofFields::NUM_FIELDS,
+                             0);
+        return true;
+    }
+
+    // See `process_defi_deposit` in rollup_circuit.cpp.
+    bool process_defi_deposit(size_t i,
+                              uint32_t rollup_id,
+                              std::vector<fr>& tx_public_inputs,
+                              std::vector<uint256_t> const& bridge_call_datas,
+                              std::vector<uint256_t>& defi_deposit_sums)
+    {
+        const uint256_t bridge_call_data = tx_public_inputs[InnerProofFields::BRIDGE_CALL_DATA];
+        const uint256_t deposit_value = tx_public_inputs[InnerProofFields::DEFI_DEPOSIT_VALUE];
+        const uint256_t tx_fee = tx_public_inputs[InnerProofFields::TX_FEE];
+        if (!fits(bridge_call_data, DEFI_BRIDGE_CALL_DATA_BIT_LENGTH) ||
+            !fits(deposit_value, DEFI_DEPOSIT_VALUE_BIT_LENGTH) || !fits(tx_fee, TX_FEE_BIT_LENGTH)) {
+            return fail(format("tx ", i, " has an out of range public input"));
+        }
+        if (uint256_t(tx_public_inputs[InnerProofFields::PROOF_ID]) != ProofIds::DEFI_DEPOSIT) {
+            return true;
+        }
+
+        size_t num_matched = 0;
+        uint32_t nonce = rollup_id * NUM_BRIDGE_CALLS_PER_BLOCK;
+        for (uint32_t k = 0; k < NUM_BRIDGE_CALLS_PER_BLOCK; ++k) {
+            if (k < num_defi_interactions && bridge_call_data == bridge_call_datas[k]) {
+                defi_deposit_sums[k] += deposit_value;
+                nonce += k;
+                ++num_matched;
+            }
+        }
+        if (num_matched != 1) {
+            return fail(format("proof bridge call data matched ", num_matched, " times"));
+        }
+
+        const auto claim_fee = tx_fee - (tx_fee >> 1);
+        auto& note_commitment1 = tx_public_inputs[InnerProofFields::NOTE_COMMITMENT1];
+        note_commitment1 = notes::native::claim::complete_partial_commitment(note_commitment1, nonce, claim_fee);
+        return true;
+    }
+
+    // See `process_chained_txs` in rollup_circuit.cpp.
+    bool process_chained_tx(size_t i,
+                            bool is_tx_real,
+                            std::vector<fr> const& tx_public_inputs,
+                            std::vector<std::vector<fr>> const& prev_txs_public_inputs)
+    {
+        const auto backward_link = tx_public_inputs[InnerProofFields::BACKWARD_LINK];
+        if (backward_link == 0) {
+            return true;
+        }
+
+        // As in the circuit, the last matching tx wins.
+        uint256_t prev_allow_chain = 0;
+        bool is_propagating_prev_output1 = false;
+        bool is_propagating_prev_output2 = false;
+        bool found_link_in_rollup = false;
+        for (size_t j = 0; j < i; ++j) {
+            auto const& prev_public_inputs = prev_txs_public_inputs[j];
+            const bool output1 = is_tx_real && backward_link == prev_public_inputs[InnerProofFields::NOTE_COMMITMENT1];
+            const bool output2 = is_tx_real && backward_link == prev_public_inputs[InnerProofFields::NOTE_COMMITMENT2];
+            if (output1 || output2) {
+                found_link_in_rollup = true;
+                prev_allow_chain = prev_public_inputs[InnerProofFields::ALLOW_CHAIN];
+                is_propagating_prev_output1 = output1;
+                is_propagating_prev_output2 = output2;
+            }
+        }
+
+        if (!found_link_in_rollup) {
+            // Padding fills in random paths, which would fail the check too.
+            if (i >= rollup.linked_commitment_paths.size() ||
+                !check_membership(rollup.old_data_root,
+                                  rollup.linked_commitment_paths[i],
+                                  backward_link,
+                                  rollup.linked_commitment_indices[i])) {
+                return fail(format("tx ",
+                                   i,
+                                   "'s linked commitment must exist. Membership check failed for backward_link ",
+                                   backward_link));
+            }
+            return true;
+        }
+
+        const uint256_t attempting_to_propagate_output_index =
+            is_propagating_prev_output1 ? 1 : (is_propagating_prev_output2 ? 2 : 0);
+        if (prev_allow_chain != attempting_to_propagate_output_index && prev_allow_chain != 3) {
+            return fail(format("tx ",
+                               i,
+                               " is not permitted to propagate output ",
+                               attempting_to_propagate_output_index,
+                               " of the prev tx. prev_allow_chain = ",
+                               prev_allow_chain));
+        }
+        return true;
+    }
+
+    // See `batch_update_membership`. The new commitments form a subtree inserted at data_start_index.
+    bool check_data_tree_update(size_t rollup_size_pow2, std::vector<fr> new_data_values)
+    {
+        new_data_values.resize(rollup_size_pow2 * 2, fr(0));
+        const auto height = numeric::get_msb(new_data_values.size());
+        const auto zero_subtree_root = compute_tree_root_native(std::vector<fr>(new_data_values.size(), 0));
+        const auto subtree_root = compute_tree_root_native(new_data_values);
+
+        if (compute_root(rollup.old_data_path, zero_subtree_root, rollup.data_start_index, height) !=
+            rollup.old_data_root) {
+            return fail("batch_update_membership_old_subtree");
+        }
+        if (compute_root(rollup.old_data_path, subtree_root, rollup.data_start_index, height) !=
+            rollup.new_data_root) {
+            return fail("batch_update_membership_new_subtree");
+        }
+        return true;
+    }
+
+    // See `check_nullifiers_inserted` in rollup_circuit.cpp.
+    bool check_nullifiers_inserted(std::vector<uint256_t> const& new_null_indicies, fr& new_null_root)
+    {
+        auto latest_null_root = rollup.old_null_root;
+        for (size_t i = 0; i < new_null_indicies.size(); ++i) {
+            const bool is_real = rollup.num_txs > i / 2 && new_null_indicies[i] != 0;
+            // This makes padding transactions act as noops.
+            const auto index = is_real ? new_null_indicies[i] : uint256_t(0);
+            auto const& path = padded(rollup.old_null_paths, i);
+
+            if (!check_membership(latest_null_root, path, fr(0), index)) {
+                return fail(format("check_nullifiers_inserted_", i, "_old_value"));
+            }
+            auto const& next_null_root = padded(rollup.new_null_roots, i);
+            if (!check_membership(next_null_root, path, is_real ? fr(1) : fr(0), index)) {
+                return fail(format("check_nullifiers_inserted_", i, "_new_value"));
+            }
+            latest_null_root = next_null_root;
+        }
+        new_null_root = latest_null_root;
+        return true;
+    }
+
+    // See `check_nullifiers_inserted_indexed` in rollup_circuit.cpp.
+    bool check_nullifiers_inserted_indexed(std::vector<uint256_t> const& new_nullifiers, fr& new_null_root)
+    {
+        auto latest_null_root = rollup.old_indexed_null_root;
+        for (size_t i = 0; i < new_nullifiers.size(); ++i) {
+            auto const& insertion = padded(rollup.indexed_null_insertions, i);
+            const auto& nullifier = new_nullifiers[i];
+            const bool is_real = rollup.num_txs > i / 2 && nullifier != 0;
+            const auto msg = format("check_nullifiers_inserted_indexed_", i);
+
+            if (is_real && uint256_t(insertion.low_leaf_value) >= nullifier) {
+                return fail(msg + "_low_value_not_below_nullifier");
+            }
+            if (is_real && insertion.low_leaf_next_value != 0 &&
+                nullifier >= uint256_t(insertion.low_leaf_next_value)) {
+                return fail(msg + "_nullifier_not_below_next_value");
+            }
+
+            const auto low_leaf = hash_indexed_leaf(
+                insertion.low_leaf_value, insertion.low_leaf_next_index, insertion.low_leaf_next_value);
+            const auto updated_low_leaf =
+                hash_indexed_leaf(insertion.low_leaf_value, insertion.new_leaf_index, fr(nullifier));
+            if (!check_update(insertion.low_updated_root,
+                              is_real ? updated_low_leaf : low_leaf,
+                              latest_null_root,
+                              insertion.low_leaf_path,
+                              low_leaf,
+                              insertion.low_leaf_index)) {
+                return fail(msg + "_low_leaf");
+            }
+
+            const auto new_leaf =
+                hash_indexed_leaf(fr(nullifier), insertion.low_leaf_next_index, insertion.low_leaf_next_value);
+            if (!check_update(insertion.new_root,
+                              is_real ? new_leaf : fr(0),
+                              insertion.low_updated_root,
+                              insertion.new_leaf_path,
+                              fr(0),
+                              insertion.new_leaf_index)) {
+                return fail(msg + "_new_leaf");
+            }
+            latest_null_root = insertion.new_root;
+        }
+        new_null_root = latest_null_root;
+        return true;
+    }
+};
+
+} // namespace
+
+validate_result validate_rollup_tx(rollup_tx const& rollup,
+                                   std::vector<std::shared_ptr<waffle::verification_key>> const& verification_keys,
+                                   size_t max_num_txs,
+                                   bool verify_inner_proofs,
+                                   ChainingCheck chaining_check,
+                                   NullifierTree nullifier_tree,
+                                   SlotMatching slot_matching,
+                                   MembershipChecks membership_checks)
+{
+    const std::vector<uint8_t> no_padding_proof;
+    validator v{ rollup,
+                 no_padding_proof,
+                 verification_keys,
+                 max_num_txs,
+                 chaining_check,
+                 nullifier_tree,
+                 slot_matching,
+                 membership_checks,
+                 "" };
+    return v.run(verify_inner_proofs);
+}
+
+validate_result validate(rollup_tx const& tx, circuit_data const& cd, bool verify_inner_proofs)
+{
+    if (cd.join_split_circuit_data.padding_proof.size() == 0) {
+        return { false, "Join split padding proof not provided.", {} };
+    }
+
+    Timer timer;
+    // Copying the tx to pad it would copy all of its proofs and paths, so the tx is validated as if padded, and left to
+    // be padded by `verify`. The number of in scope bridge call datas and asset ids is read from the tx, which records
+    // it before padding, rather than from its vectors, which may already be padded.
+    validator v{ tx,
+                 cd.join_split_circuit_data.padding_proof,
+                 cd.verification_keys,
+                 cd.num_txs,
+                 cd.chaining_check,
+                 cd.nullifier_tree,
+                 cd.slot_matching,
+                 cd.membership_checks,
+                 "" };
+    auto result = v.run(verify_inner_proofs);
+
+    if (result.valid) {
+        info("tx rollup: Validated natively in ", timer.toString(), "s");
+    } else {
+        info("tx rollup: Native validation failed: ", result.err);
+    }
+    return result;
+}
+
+} // namespace rollup
+} // namespace proofs
+} // namespace rollup
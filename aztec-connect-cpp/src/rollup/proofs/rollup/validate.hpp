@@ -0,0 +1,40 @@
+#pragma once
+#include "compute_circuit_data.hpp"
+#include "rollup_tx.hpp"
+
+namespace rollup {
+namespace proofs {
+namespace rollup {
+
+struct validate_result {
+    bool valid = false;
+    std::string err;
+    // The public inputs the rollup circuit would output, excluding the trailing recursion output limbs, which are
+    // only known once the inner proofs have been recursively aggregated.
+    std::vector<fr> public_inputs;
+};
+
+/**
+ * Natively replays the checks made by `rollup_circuit`, built with the given options, on a padded rollup_tx, without
+ * building any constraints. Circuits built with `MembershipChecks` are not supported, and always fail validation.
+ * Inner proofs are checked with the native verifier if `verify_inner_proofs` is set.
+ * Returns the first rule broken, with the same message the circuit would fail with where there is one.
+ */
+validate_result validate_rollup_tx(rollup_tx const& rollup,
+                                   std::vector<std::shared_ptr<waffle::verification_key>> const& verification_keys,
+                                   size_t max_num_txs,
+                                   bool verify_inner_proofs = true,
+                                   ChainingCheck chaining_check = ChainingCheck::QUADRATIC,
+                                   NullifierTree nullifier_tree = NullifierTree::SPARSE,
+                                   SlotMatching slot_matching = SlotMatching::SCAN,
+                                   MembershipChecks membership_checks = {});
+
+/**
+ * Validates an unpadded tx against the given circuit data and its options, as if padded as `verify_logic` would.
+ * Reports in milliseconds what `verify_logic` takes minutes to report.
+ */
+validate_result validate(rollup_tx const& tx, circuit_data const& cd, bool verify_inner_proofs = true);
+
+} // namespace rollup
+} // namespace proofs
+} // namespace rollup
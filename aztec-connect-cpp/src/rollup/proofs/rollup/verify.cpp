@@ -1,11 +1,12 @@
 #include "./verify.hpp"
+#include "../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace rollup {
 
 using namespace barretenberg;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 namespace {
 verify_result<Composer> build_circuit(Composer& composer, rollup_tx& tx, circuit_data const& cd)
@@ -24,7 +25,14 @@ verify_result<Composer> build_circuit(Composer& composer, rollup_tx& tx, circuit
 
     pad_rollup_tx(tx, cd.num_txs, cd.join_split_circuit_data.padding_proof);
 
-    result.recursion_output = rollup_circuit(composer, tx, cd.verification_keys, cd.num_txs);
+    result.recursion_output = rollup_circuit(composer,
+                                             tx,
+                                             cd.verification_keys,
+                                             cd.num_txs,
+                                             cd.chaining_check,
+                                             cd.nullifier_tree,
+                                             cd.slot_matching,
+                                             cd.membership_checks);
     return result;
 }
 } // namespace
@@ -32,12 +40,14 @@ verify_result<Composer> build_circuit(Composer& composer, rollup_tx& tx, circuit
 verify_result<Composer> verify_logic(rollup_tx& tx, circuit_data const& cd)
 {
     Composer composer = Composer(cd.proving_key, cd.verification_key, cd.num_gates);
+    reserve_witness_capacity(composer, cd);
     return verify_logic_internal(composer, tx, cd, "tx rollup", build_circuit);
 }
 
 verify_result<Composer> verify(rollup_tx& tx, circuit_data const& cd)
 {
     Composer composer = Composer(cd.proving_key, cd.verification_key, cd.num_gates);
+    reserve_witness_capacity(composer, cd);
     return verify_internal(composer, tx, cd, "tx rollup", true, build_circuit);
 }
 
@@ -1,12 +1,13 @@
 #pragma once
 #include "compute_circuit_data.hpp"
 #include "rollup_tx.hpp"
+#include "../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace rollup {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 verify_result<Composer> verify_logic(rollup_tx& tx, circuit_data const& cd);
 
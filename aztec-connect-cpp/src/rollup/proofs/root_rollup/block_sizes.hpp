@@ -0,0 +1,120 @@
+#pragma once
+#include "../rollup/rollup_proof_view.hpp"
+#include <common/log.hpp>
+#include <common/numeric/bitop/get_msb.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace rollup {
+namespace proofs {
+namespace root_rollup {
+
+/**
+ * Picks the tx rollup and root rollup circuits for the rollups of a block, from the configured sizes.
+ *
+ * A root rollup only verifies inner rollup proofs of one tx rollup circuit. Every inner rollup of a block is full but
+ * the last, so sizing each to fit its own txs would give the last a smaller circuit than the rest, and the root rollup
+ * would reject the block. Instead, the block's inner rollup size is fixed by its first inner rollup, or by the inner
+ * proofs its root rollup is started with, and every inner rollup of the block is padded up to it. `finish_block`
+ * frees the size for the next block, once the root rollup has been made.
+ */
+class block_sizes {
+  public:
+    block_sizes() = default;
+
+    // Both lists of sizes must be ascending.
+    block_sizes(std::vector<size_t> txs_per_inner, std::vector<size_t> inners_per_root)
+        : txs_per_inner_(std::move(txs_per_inner))
+        , inners_per_root_(std::move(inners_per_root))
+    {}
+
+    /**
+     * The number of txs to pad an inner rollup of `num_txs` txs to: the block's inner rollup size, or if the block has
+     * none yet, the smallest that fits, which then becomes the block's.
+     * Returns 0 if no tx rollup circuit fits, or the txs don't fit the block's.
+     */
+    size_t inner_rollup_size(size_t num_txs)
+    {
+        if (!block_txs_per_inner_) {
+            block_txs_per_inner_ = smallest_fitting_size(txs_per_inner_, num_txs);
+            if (!block_txs_per_inner_) {
+                info("No tx rollup circuit fits ", num_txs, " txs.");
+            }
+            return block_txs_per_inner_;
+        }
+        if (num_txs > block_txs_per_inner_) {
+            info("Inner rollup of ", num_txs, " txs does not fit the block's inner rollups of ", block_txs_per_inner_);
+            return 0;
+        }
+        return block_txs_per_inner_;
+    }
+
+    /**
+     * Picks the smallest root rollup circuit that fits the given inner rollup proofs, as {txs per inner rollup, inner
+     * rollups}. All inner proofs of a root rollup must come from the block's tx rollup circuit, whose size is read
+     * from the proofs. If there are no proofs yet, the block's inner rollup size is assumed, or if it has none, the
+     * largest, which only a one-shot root rollup may rely on.
+     * Returns {0, 0} if no configured circuit fits.
+     */
+    std::pair<size_t, size_t> root_rollup_size(std::vector<std::vector<uint8_t>> const& inner_proofs,
+                                               size_t num_inner_proofs)
+    {
+        auto num_txs = block_txs_per_inner_ ? block_txs_per_inner_ : txs_per_inner_.back();
+        if (!inner_proofs.empty()) {
+            auto rollup_size = rollup::rollup_proof_view(inner_proofs[0]).rollup_size();
+            for (auto const& proof : inner_proofs) {
+                if (rollup::rollup_proof_view(proof).rollup_size() != rollup_size) {
+                    info("Inner rollup proofs have mixed sizes.");
+                    return { 0, 0 };
+                }
+            }
+            auto it = std::find_if(txs_per_inner_.begin(), txs_per_inner_.end(), [&](size_t n) {
+                return tx_rollup_size_pow2(n) == rollup_size;
+            });
+            if (it == txs_per_inner_.end()) {
+                info("No tx rollup circuit of size ", rollup_size, ".");
+                return { 0, 0 };
+            }
+            if (block_txs_per_inner_ && *it != block_txs_per_inner_) {
+                info("Inner rollup proofs of size ", rollup_size, " are not of the block's inner rollup circuit.");
+                return { 0, 0 };
+            }
+            num_txs = block_txs_per_inner_ = *it;
+        }
+
+        auto num_rollups = smallest_fitting_size(inners_per_root_, std::max(inner_proofs.size(), num_inner_proofs));
+        if (!num_rollups) {
+            info("No root rollup circuit fits ", num_inner_proofs, " inner rollups.");
+            return { 0, 0 };
+        }
+        return { num_txs, num_rollups };
+    }
+
+    // The block's inner rollup size, or 0 if it has none yet.
+    size_t block_txs_per_inner() const { return block_txs_per_inner_; }
+
+    void finish_block() { block_txs_per_inner_ = 0; }
+
+    // Returns the smallest of the given ascending sizes that can hold n, or 0 if there is none.
+    static size_t smallest_fitting_size(std::vector<size_t> const& sizes, size_t n)
+    {
+        auto it = std::lower_bound(sizes.begin(), sizes.end(), n);
+        return it == sizes.end() ? 0 : *it;
+    }
+
+    // The circuit size of a tx rollup of num_txs, as found in the ROLLUP_SIZE public input of its proofs.
+    static size_t tx_rollup_size_pow2(size_t num_txs)
+    {
+        auto floor = 1UL << numeric::get_msb(num_txs);
+        return num_txs == floor ? num_txs : floor << 1UL;
+    }
+
+  private:
+    std::vector<size_t> txs_per_inner_;
+    std::vector<size_t> inners_per_root_;
+    size_t block_txs_per_inner_ = 0;
+};
+
+} // namespace root_rollup
+} // namespace proofs
+} // namespace rollup
@@ -0,0 +1,36 @@
+#include "block_sizes.hpp"
+#include <gtest/gtest.h>
+
+using namespace rollup::proofs::root_rollup;
+
+TEST(root_rollup_block_sizes, partial_last_inner_rollup_is_padded_to_the_first)
+{
+    block_sizes sizes({ 1, 2, 4 }, { 1, 3 });
+
+    // A block of 9 txs, in inner rollups of 4, 4 and 1.
+    EXPECT_EQ(sizes.inner_rollup_size(4), 4UL);
+    EXPECT_EQ(sizes.inner_rollup_size(4), 4UL);
+    EXPECT_EQ(sizes.inner_rollup_size(1), 4UL);
+    EXPECT_EQ(sizes.root_rollup_size({}, 3), std::make_pair(4UL, 3UL));
+
+    // The next block is sized afresh.
+    sizes.finish_block();
+    EXPECT_EQ(sizes.inner_rollup_size(2), 2UL);
+}
+
+TEST(root_rollup_block_sizes, inner_rollup_larger_than_the_blocks_fails)
+{
+    block_sizes sizes({ 1, 2, 4 }, { 1, 3 });
+
+    EXPECT_EQ(sizes.inner_rollup_size(2), 2UL);
+    EXPECT_EQ(sizes.inner_rollup_size(3), 0UL);
+    EXPECT_EQ(sizes.block_txs_per_inner(), 2UL);
+}
+
+TEST(root_rollup_block_sizes, no_fitting_circuit_fails)
+{
+    block_sizes sizes({ 1, 2 }, { 1 });
+
+    EXPECT_EQ(sizes.inner_rollup_size(3), 0UL);
+    EXPECT_EQ(sizes.root_rollup_size({}, 2), std::make_pair(0UL, 0UL));
+}
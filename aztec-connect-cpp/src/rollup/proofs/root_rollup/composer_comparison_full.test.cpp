@@ -0,0 +1,74 @@
+#include <common/test.hpp>
+#include "index.hpp"
+#include "../../constants.hpp"
+
+namespace rollup {
+namespace proofs {
+namespace root_rollup {
+
+namespace {
+std::shared_ptr<waffle::DynamicFileReferenceStringFactory> srs;
+} // namespace
+
+/**
+ * Compares the rollup circuits, as built with the composer this build targets (see `circuit_types.hpp`), with the
+ * turbo circuits whose gate counts are recorded in `circuit_gate_count`. No circuit may outgrow the power of two size
+ * of its turbo circuit, which fixes its proving cost and the srs it needs.
+ *
+ * Each circuit is built in the configuration its regression test counts gates in. Build, proving key and padding proof
+ * times are reported by `get_circuit_data` through the benchmark collator, under the composer's name, so the output of
+ * a default build and of a -DPLOOKUP_CIRCUITS=ON build can be compared side by side.
+ */
+class composer_comparison_full_tests : public ::testing::Test {
+  protected:
+    static constexpr auto CRS_PATH = "../barretenberg/cpp/srs_db/ignition";
+
+    static void SetUpTestCase() { srs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(CRS_PATH); }
+
+    void compare(std::string const& name, size_t num_gates, uint32_t turbo_num_gates, uint32_t turbo_size)
+    {
+        info(name,
+             ": ",
+             GET_COMPOSER_NAME_STRING(Composer),
+             " gates: ",
+             num_gates,
+             ", TurboPlonk gates: ",
+             turbo_num_gates,
+             ", ratio: ",
+             static_cast<double>(num_gates) / static_cast<double>(turbo_num_gates));
+        EXPECT_LE(num_gates, turbo_size - waffle::ComposerBase::NUM_RESERVED_GATES)
+            << name << " is larger than its turbo circuit's size.";
+    }
+};
+
+HEAVY_TEST_F(composer_comparison_full_tests, compare_with_turbo_gate_counts)
+{
+    if (circuit_types::is_reference_composer) {
+        GTEST_SKIP() << "The turbo circuits' counts are checked by their own regression tests.";
+    }
+
+    auto account_cd = account::get_circuit_data(srs);
+    compare("account", account_cd.num_gates, circuit_gate_count::ACCOUNT, circuit_gate_next_power_of_two::ACCOUNT);
+
+    auto js_cd = join_split::get_circuit_data(srs);
+    compare(
+        "join split", js_cd.num_gates, circuit_gate_count::JOIN_SPLIT, circuit_gate_next_power_of_two::JOIN_SPLIT);
+
+    auto claim_cd = claim::get_circuit_data(srs);
+    compare("claim", claim_cd.num_gates, circuit_gate_count::CLAIM, circuit_gate_next_power_of_two::CLAIM);
+
+    auto tx_rollup1_cd = rollup::get_circuit_data(1, js_cd, account_cd, claim_cd, srs, "", true, false, false);
+    compare(
+        "tx rollup 1", tx_rollup1_cd.num_gates, circuit_gate_count::ROLLUP, circuit_gate_next_power_of_two::ROLLUP);
+
+    auto tx_rollup2_cd = rollup::get_circuit_data(2, js_cd, account_cd, claim_cd, srs, "", true, false, false);
+    auto root_rollup_cd = get_circuit_data(3, tx_rollup2_cd, srs, "", true, false, false);
+    compare("root rollup 3x2",
+            root_rollup_cd.num_gates,
+            circuit_gate_count::ROOT_ROLLUP,
+            circuit_gate_next_power_of_two::ROOT_ROLLUP);
+}
+
+} // namespace root_rollup
+} // namespace proofs
+} // namespace rollup
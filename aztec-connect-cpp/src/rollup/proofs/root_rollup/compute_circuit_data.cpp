@@ -21,13 +21,17 @@ circuit_data get_circuit_data(size_t num_inner_rollups,
                               bool load,
                               bool pk,
                               bool vk,
-                              bool mock)
+                              bool mock,
+                              rollup::SlotMatching slot_matching)
 {
     auto rollup_size = num_inner_rollups * rollup_circuit_data.rollup_size;
     auto floor = 1UL << numeric::get_msb(rollup_size);
     auto rollup_size_pow2 = rollup_size == floor ? rollup_size : floor << 1UL;
     std::cerr << "Getting root rollup circuit data: (size: " << rollup_size_pow2 << ")" << std::endl;
     auto name = format("root_rollup_", rollup_circuit_data.num_txs, "x", num_inner_rollups);
+    if (slot_matching == rollup::SlotMatching::LOOKUP) {
+        name += "_lookup_slot_matching";
+    }
 
     auto build_circuit = [&](Composer& composer) {
         auto gibberish_roots_path =
@@ -52,7 +56,8 @@ circuit_data get_circuit_data(size_t num_inner_rollups,
                             root_rollup,
                             rollup_circuit_data.rollup_size,
                             rollup_size_pow2,
-                            rollup_circuit_data.verification_key);
+                            rollup_circuit_data.verification_key,
+                            slot_matching);
     };
 
     auto cd = proofs::get_circuit_data<Composer>("root rollup",
@@ -67,10 +72,12 @@ circuit_data get_circuit_data(size_t num_inner_rollups,
                                                  true,
                                                  mock,
                                                  build_circuit,
-                                                 format(" ", rollup_circuit_data.num_txs, "x", num_inner_rollups));
+                                                 format(" ", rollup_circuit_data.num_txs, "x", num_inner_rollups),
+                                                 { rollup_circuit_data.verification_key });
 
     circuit_data data;
     data.num_gates = cd.num_gates;
+    data.shape = cd.shape;
     data.srs = cd.srs;
     data.padding_proof = cd.padding_proof;
     data.proving_key = cd.proving_key;
@@ -78,6 +85,7 @@ circuit_data get_circuit_data(size_t num_inner_rollups,
     data.num_inner_rollups = num_inner_rollups;
     data.rollup_size = rollup_size_pow2;
     data.inner_rollup_circuit_data = rollup_circuit_data;
+    data.slot_matching = slot_matching;
     data.mock = cd.mock;
 
     return data;
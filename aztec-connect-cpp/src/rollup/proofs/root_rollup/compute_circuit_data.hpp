@@ -9,6 +9,7 @@ struct circuit_data : proofs::circuit_data {
     size_t num_inner_rollups;
     size_t rollup_size;
     rollup::circuit_data inner_rollup_circuit_data;
+    rollup::SlotMatching slot_matching = rollup::SlotMatching::SCAN;
 };
 
 circuit_data get_circuit_data(size_t num_inner_rollups,
@@ -20,7 +21,8 @@ circuit_data get_circuit_data(size_t num_inner_rollups,
                               bool load = true,
                               bool pk = true,
                               bool vk = true,
-                              bool mock = false);
+                              bool mock = false,
+                              rollup::SlotMatching slot_matching = rollup::SlotMatching::SCAN);
 
 } // namespace root_rollup
 } // namespace proofs
@@ -1,7 +1,10 @@
+#include "block_sizes.hpp"
 #include "compute_circuit_data.hpp"
 #include "create_root_rollup_tx.hpp"
 #include "root_rollup_circuit.hpp"
 #include "root_rollup_broadcast_data.hpp"
+#include "root_rollup_broadcast_view.hpp"
 #include "root_rollup_proof_data.hpp"
+#include "root_rollup_session.hpp"
 #include "root_rollup_tx.hpp"
 #include "verify.hpp"
\ No newline at end of file
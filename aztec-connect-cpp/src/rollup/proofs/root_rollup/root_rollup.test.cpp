@@ -54,9 +54,9 @@ class root_rollup_tests : public ::testing::Test {
         std::filesystem::create_directories(TEST_PROOFS_PATH);
         srs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(CRS_PATH);
 
-        account_cd = proofs::account::get_circuit_data(srs);
-        js_cd = join_split::get_circuit_data(srs);
-        claim_cd = proofs::claim::get_circuit_data(srs);
+        account_cd = proofs::account::get_circuit_data(srs, false, FIXTURE_PATH, true, persist, persist);
+        js_cd = join_split::get_circuit_data(srs, false, FIXTURE_PATH, true, persist, persist);
+        claim_cd = proofs::claim::get_circuit_data(srs, false, FIXTURE_PATH, true, persist, persist);
 
         if (recreate) {
             // If no fixtures dir, recreate all proving keys, verification keys, padding proofs etc.
@@ -211,6 +211,25 @@ TEST_F(root_rollup_tests, test_2_real_1_padding)
     ASSERT_TRUE(result.logic_verified);
 }
 
+// The last inner rollup of a block is partly filled, but must be padded to the size of the others for the root rollup
+// to take it.
+TEST_F(root_rollup_tests, test_block_with_partial_last_inner_rollup)
+{
+    block_sizes sizes({ 1, INNER_ROLLUP_TXS }, { ROLLUPS_PER_ROLLUP });
+    RollupStructure block = { { js_proofs[0], js_proofs[1] }, { js_proofs[2] } };
+    for (auto const& txs : block) {
+        EXPECT_EQ(sizes.inner_rollup_size(txs.size()), INNER_ROLLUP_TXS);
+    }
+
+    auto tx_data = create_root_rollup_tx("root_211", block);
+    auto [num_txs, num_rollups] = sizes.root_rollup_size(tx_data.rollups, tx_data.num_inner_proofs);
+    EXPECT_EQ(num_txs, INNER_ROLLUP_TXS);
+    EXPECT_EQ(num_rollups, ROLLUPS_PER_ROLLUP);
+
+    auto result = verify_logic(tx_data, root_rollup_cd);
+    ASSERT_TRUE(result.logic_verified);
+}
+
 TEST_F(root_rollup_tests, test_3_real_0_padding)
 {
     auto tx_data = create_root_rollup_tx(
@@ -284,6 +303,45 @@ TEST_F(root_rollup_tests, test_encode_inputs)
 
     auto hash_output = broadcast_data.compute_hash();
     EXPECT_EQ(hash_output, proof_data.input_hash);
+
+    auto broadcast_buf = to_buffer(broadcast_data);
+    auto broadcast_view = root_rollup_broadcast_view(broadcast_buf);
+    EXPECT_EQ(broadcast_view.size(), broadcast_buf.size());
+    EXPECT_EQ(broadcast_view.compute_hash(), proof_data.input_hash);
+}
+
+TEST_F(root_rollup_tests, test_session_matches_verify_logic)
+{
+    auto tx_data = create_root_rollup_tx("root_211", { { js_proofs[0], js_proofs[1] }, { js_proofs[2] } });
+
+    auto header = tx_data;
+    header.rollups.clear();
+    root_rollup_session session(header, root_rollup_cd);
+    for (auto const& proof : tx_data.rollups) {
+        EXPECT_TRUE(session.add(proof));
+    }
+    auto session_result = session.finish_logic();
+
+    auto result = verify_logic(tx_data, root_rollup_cd);
+    ASSERT_TRUE(result.logic_verified);
+    ASSERT_TRUE(session_result.logic_verified);
+    EXPECT_EQ(session_result.broadcast_data, result.broadcast_data);
+    EXPECT_EQ(session_result.public_inputs, result.public_inputs);
+    EXPECT_EQ(session_result.number_of_gates, result.number_of_gates);
+}
+
+TEST_F(root_rollup_tests, test_session_rejects_out_of_order_proof)
+{
+    auto tx_data =
+        create_root_rollup_tx("root_221", { { js_proofs[0], js_proofs[1] }, { js_proofs[2], js_proofs[3] } });
+
+    auto header = tx_data;
+    header.rollups.clear();
+    root_rollup_session session(header, root_rollup_cd);
+    EXPECT_TRUE(session.add(tx_data.rollups[1]));
+    EXPECT_FALSE(session.add(tx_data.rollups[0]));
+    EXPECT_TRUE(session.failed());
+    EXPECT_FALSE(session.finish_logic().logic_verified);
 }
 
 TEST_F(root_rollup_tests, test_asset_ids_missing_fails)
@@ -340,6 +398,46 @@ TEST_F(root_rollup_tests, test_bridge_call_datas_reordering)
     ASSERT_TRUE(result.logic_verified);
 }
 
+TEST_F(root_rollup_tests, test_lookup_slot_matching_matches_scan)
+{
+    auto tx_data = create_full_logic_root_rollup_tx();
+    auto result = verify_logic(tx_data, root_rollup_cd);
+    ASSERT_TRUE(result.logic_verified);
+
+    auto cd = root_rollup_cd;
+    cd.slot_matching = rollup::SlotMatching::LOOKUP;
+    auto lookup_result = verify_logic(tx_data, cd);
+    ASSERT_TRUE(lookup_result.logic_verified);
+    EXPECT_EQ(lookup_result.broadcast_data, result.broadcast_data);
+    EXPECT_EQ(lookup_result.public_inputs, result.public_inputs);
+
+    info("root rollup gates: scan ", result.number_of_gates, ", lookup ", lookup_result.number_of_gates);
+    EXPECT_LT(lookup_result.number_of_gates, result.number_of_gates);
+}
+
+TEST_F(root_rollup_tests, test_lookup_slot_matching_asset_ids_missing_fails)
+{
+    auto tx_data = create_full_logic_root_rollup_tx();
+    tx_data.asset_ids[0] = tx_data.asset_ids[1]; // asset_ids = [0, aid3, aid3, aid2]
+
+    auto cd = root_rollup_cd;
+    cd.slot_matching = rollup::SlotMatching::LOOKUP;
+    auto result = verify_logic(tx_data, cd);
+    ASSERT_FALSE(result.logic_verified);
+}
+
+TEST_F(root_rollup_tests, test_lookup_slot_matching_bridge_call_datas_repeating_fails)
+{
+    auto tx_data = create_full_logic_root_rollup_tx();
+    tx_data.bridge_call_datas[1] = tx_data.bridge_call_datas[0]; // bridge_call_datas = [bid2, bid2, 0, 0]
+
+    auto cd = root_rollup_cd;
+    cd.slot_matching = rollup::SlotMatching::LOOKUP;
+    auto result = verify_logic(tx_data, cd);
+    ASSERT_FALSE(result.logic_verified);
+    EXPECT_EQ(result.err, "bridge call datas are not distinct");
+}
+
 // Full logic tests
 TEST_F(root_rollup_tests, test_full_logic)
 {
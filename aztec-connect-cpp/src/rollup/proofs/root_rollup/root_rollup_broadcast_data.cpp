@@ -1,8 +1,8 @@
 #include "root_rollup_broadcast_data.hpp"
 #include "../inner_proof_data/inner_proof_data.hpp"
 #include "../../constants.hpp"
-#include <crypto/sha256/sha256.hpp>
-#include <common/container.hpp>
+#include "sha256_hasher.hpp"
+#include <common/thread.hpp>
 
 namespace rollup {
 namespace proofs {
@@ -56,24 +56,72 @@ root_rollup_broadcast_data::root_rollup_broadcast_data(std::vector<fr> const& fi
     }
 }
 
-fr root_rollup_broadcast_data::compute_hash() const
+namespace {
+void hash_tx(sha256_hasher& hasher, tx_broadcast_data const& tx)
 {
-    // Slice off the fields representing the tx public inputs.
-    std::vector<uint8_t> hash_inputs = slice(to_buffer(*this), 0, RootRollupBroadcastFields::INNER_PROOFS_DATA * 32);
+    hasher.update(tx.proof_id);
+    hasher.update(tx.note_commitment1);
+    hasher.update(tx.note_commitment2);
+    hasher.update(tx.nullifier1);
+    hasher.update(tx.nullifier2);
+    hasher.update(tx.public_value);
+    hasher.update(tx.public_owner);
+    hasher.update(tx.asset_id);
+}
+} // namespace
 
-    // Write the hashes representing the tx public inputs.
+/**
+ * Hashes the header fields (in serialization order) followed by a hash of each inner rollup's tx records.
+ * Fields are fed straight into the hasher, so no intermediate buffers are built. Inner rollup hashes are independent,
+ * and are computed in parallel.
+ */
+fr root_rollup_broadcast_data::compute_hash() const
+{
     size_t num_inner_rollups = static_cast<uint32_t>(num_inner_proofs);
     size_t num_txs_per_rollup = static_cast<uint32_t>(rollup_size) / num_inner_rollups;
-    for (size_t i = 0; i < num_inner_rollups; ++i) {
-        std::vector<uint8_t> inner_inputs;
+
+    std::vector<fr> inner_hashes(num_inner_rollups);
+    parallel_for(num_inner_rollups, [&](size_t i) {
+        sha256_hasher inner_hasher;
         for (size_t j = 0; j < num_txs_per_rollup; ++j) {
-            write(inner_inputs, tx_data[i * num_txs_per_rollup + j]);
+            hash_tx(inner_hasher, tx_data[i * num_txs_per_rollup + j]);
         }
-        auto inner_hash = sha256::sha256_to_field(inner_inputs);
-        write(hash_inputs, inner_hash);
+        inner_hashes[i] = inner_hasher.finalize_to_field();
+    });
+
+    sha256_hasher hasher;
+    for (auto field : { rollup_id,
+                        rollup_size,
+                        data_start_index,
+                        old_data_root,
+                        new_data_root,
+                        old_null_root,
+                        new_null_root,
+                        old_data_roots_root,
+                        new_data_roots_root,
+                        old_defi_root,
+                        new_defi_root }) {
+        hasher.update(field);
+    }
+    auto hash_fields = [&](auto const& fields) {
+        for (auto const& field : fields) {
+            hasher.update(field);
+        }
+    };
+    hash_fields(bridge_call_datas);
+    hash_fields(deposit_sums);
+    hash_fields(asset_ids);
+    hash_fields(total_tx_fees);
+    hash_fields(defi_interaction_notes);
+    hasher.update(previous_defi_interaction_hash);
+    hasher.update(rollup_beneficiary);
+    hasher.update(num_inner_proofs);
+
+    for (auto const& inner_hash : inner_hashes) {
+        hasher.update(inner_hash);
     }
 
-    return sha256::sha256_to_field(hash_inputs);
+    return hasher.finalize_to_field();
 }
 
 } // namespace root_rollup
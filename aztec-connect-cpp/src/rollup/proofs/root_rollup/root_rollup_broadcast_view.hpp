@@ -0,0 +1,114 @@
+#pragma once
+#include "root_rollup_broadcast_data.hpp"
+#include "sha256_hasher.hpp"
+#include "../rollup/rollup_proof_view.hpp"
+#include <common/serialize.hpp>
+#include <common/thread.hpp>
+
+namespace rollup {
+namespace proofs {
+namespace root_rollup {
+
+/**
+ * Serializes the broadcast fields output by the root rollup circuit.
+ * The fields are already in RootRollupBroadcastFields order, so the result is byte-identical to
+ * `to_buffer(root_rollup_broadcast_data(fields))` without building the intermediate structure.
+ */
+inline void write_broadcast_fields(std::vector<uint8_t>& buf, std::vector<fr> const& fields)
+{
+    auto offset = buf.size();
+    buf.resize(offset + fields.size() * 32);
+    auto ptr = buf.data() + offset;
+    for (auto const& field : fields) {
+        fr::serialize_to_buffer(field, ptr);
+        ptr += 32;
+    }
+}
+
+/**
+ * A non-owning view over serialized root rollup broadcast data, laid out as per RootRollupBroadcastFields.
+ * Unlike `root_rollup_broadcast_data`, fields are deserialized on access and the tx records are exposed as a range of
+ * views rather than copied into a vector.
+ * The underlying buffer must outlive the view.
+ */
+struct root_rollup_broadcast_view {
+    static constexpr size_t HEADER_SIZE = RootRollupBroadcastFields::INNER_PROOFS_DATA * 32;
+
+    uint8_t const* data;
+
+    root_rollup_broadcast_view(uint8_t const* broadcast_data)
+        : data(broadcast_data)
+    {}
+    root_rollup_broadcast_view(std::vector<uint8_t> const& broadcast_data)
+        : data(broadcast_data.data())
+    {}
+    // A view must not be taken over a temporary buffer.
+    root_rollup_broadcast_view(std::vector<uint8_t>&&) = delete;
+
+    fr rollup_id() const { return field(RootRollupBroadcastFields::ROLLUP_ID); }
+    fr rollup_size() const { return field(RootRollupBroadcastFields::ROLLUP_SIZE); }
+    fr data_start_index() const { return field(RootRollupBroadcastFields::DATA_START_INDEX); }
+    fr old_data_root() const { return field(RootRollupBroadcastFields::OLD_DATA_ROOT); }
+    fr new_data_root() const { return field(RootRollupBroadcastFields::NEW_DATA_ROOT); }
+    fr old_null_root() const { return field(RootRollupBroadcastFields::OLD_NULL_ROOT); }
+    fr new_null_root() const { return field(RootRollupBroadcastFields::NEW_NULL_ROOT); }
+    fr old_data_roots_root() const { return field(RootRollupBroadcastFields::OLD_DATA_ROOTS_ROOT); }
+    fr new_data_roots_root() const { return field(RootRollupBroadcastFields::NEW_DATA_ROOTS_ROOT); }
+    fr old_defi_root() const { return field(RootRollupBroadcastFields::OLD_DEFI_ROOT); }
+    fr new_defi_root() const { return field(RootRollupBroadcastFields::NEW_DEFI_ROOT); }
+    fr bridge_call_data(size_t i) const { return field(RootRollupBroadcastFields::DEFI_BRIDGE_CALL_DATAS + i); }
+    fr deposit_sum(size_t i) const { return field(RootRollupBroadcastFields::DEFI_BRIDGE_DEPOSITS + i); }
+    fr asset_id(size_t i) const { return field(RootRollupBroadcastFields::ASSET_IDS + i); }
+    fr total_tx_fee(size_t i) const { return field(RootRollupBroadcastFields::TOTAL_TX_FEES + i); }
+    fr defi_interaction_note(size_t i) const { return field(RootRollupBroadcastFields::DEFI_INTERACTION_NOTES + i); }
+    fr previous_defi_interaction_hash() const
+    {
+        return field(RootRollupBroadcastFields::PREVIOUS_DEFI_INTERACTION_HASH);
+    }
+    fr rollup_beneficiary() const { return field(RootRollupBroadcastFields::ROLLUP_BENEFICIARY); }
+    fr num_inner_proofs() const { return field(RootRollupBroadcastFields::NUM_INNER_PROOFS); }
+
+    // Fields encoding small integers are read directly from their low 4 bytes.
+    uint32_t rollup_size_u32() const { return u32(RootRollupBroadcastFields::ROLLUP_SIZE); }
+    uint32_t num_inner_proofs_u32() const { return u32(RootRollupBroadcastFields::NUM_INNER_PROOFS); }
+
+    rollup::propagated_inner_proofs_range tx_data() const { return { data + HEADER_SIZE, rollup_size_u32() }; }
+
+    // Total length in bytes of the serialized broadcast data.
+    size_t size() const { return HEADER_SIZE + rollup_size_u32() * rollup::propagated_inner_proof_view::SIZE; }
+
+    fr compute_hash() const;
+
+  private:
+    fr field(size_t index) const { return from_buffer<fr>(data + index * 32); }
+    uint32_t u32(size_t index) const { return from_buffer<uint32_t>(data + index * 32 + 28); }
+};
+
+/**
+ * Computes the same hash as `root_rollup_broadcast_data::compute_hash`, hashing straight out of the serialized
+ * buffer. The header is already contiguous, and each inner rollup's tx records are a contiguous slice.
+ */
+inline fr root_rollup_broadcast_view::compute_hash() const
+{
+    size_t num_inner_rollups = num_inner_proofs_u32();
+    size_t num_txs_per_rollup = rollup_size_u32() / num_inner_rollups;
+    size_t inner_len = num_txs_per_rollup * rollup::propagated_inner_proof_view::SIZE;
+
+    std::vector<fr> inner_hashes(num_inner_rollups);
+    parallel_for(num_inner_rollups, [&](size_t i) {
+        sha256_hasher inner_hasher;
+        inner_hasher.update(data + HEADER_SIZE + i * inner_len, inner_len);
+        inner_hashes[i] = inner_hasher.finalize_to_field();
+    });
+
+    sha256_hasher hasher;
+    hasher.update(data, HEADER_SIZE);
+    for (auto const& inner_hash : inner_hashes) {
+        hasher.update(inner_hash);
+    }
+    return hasher.finalize_to_field();
+}
+
+} // namespace root_rollup
+} // namespace proofs
+} // namespace rollup
@@ -9,6 +9,8 @@
 #include <common/map.hpp>
 #include <common/container.hpp>
 #include "./root_rollup_proof_data.hpp"
+#include "../circuit_types.hpp"
+#include "../gate_profiler.hpp"
 
 // #pragma GCC diagnostic ignored "-Wunused-variable"
 // #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -16,7 +18,7 @@ namespace rollup {
 namespace proofs {
 namespace root_rollup {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace plonk::stdlib::recursion;
 using namespace plonk::stdlib::merkle_tree;
 using namespace notes;
@@ -60,6 +62,7 @@ field_ct process_defi_interaction_notes(Composer& composer,
                                         std::vector<circuit::defi_interaction::note> const& defi_interaction_notes,
                                         std::vector<field_ct>& defi_interaction_note_commitments)
 {
+    gate_scope scope(composer, __FUNCTION__);
     std::vector<field_ct> hash_input;
 
     for (uint32_t i = 0; i < NUM_INTERACTION_RESULTS_PER_BLOCK; i++) {
@@ -95,13 +98,32 @@ field_ct process_defi_interaction_notes(Composer& composer,
     return field_ct(hash_output);
 }
 
+/**
+ * If `asset_id_lookup` is given, the matches and the tx fees are added to it instead, and `total_tx_fees` is left
+ * alone. The same applies to `bridge_call_data_lookup` below.
+ */
 void check_asset_ids_and_accumulate_tx_fees(Composer& composer,
                                             uint32_t const i,
                                             std::vector<field_ct>& total_tx_fees,
                                             std::vector<field_ct> const& asset_ids,
                                             std::vector<field_ct> const& public_inputs,
-                                            bool_ct const& is_real)
+                                            bool_ct const& is_real,
+                                            rollup::slot_lookup* asset_id_lookup)
 {
+    gate_scope scope(composer, __FUNCTION__);
+    if (asset_id_lookup) {
+        for (size_t j = 0; j < NUM_ASSETS; j++) {
+            auto inner_asset_id = public_inputs[rollup::RollupProofFields::ASSET_IDS + j];
+            auto inner_tx_fee = public_inputs[rollup::RollupProofFields::TOTAL_TX_FEES + j];
+            auto is_asset_id_padded = (inner_asset_id == field_ct(MAX_NUM_ASSETS));
+            asset_id_lookup->add(inner_asset_id,
+                                 inner_tx_fee,
+                                 is_real && !is_asset_id_padded,
+                                 format("rollup proof ", i, "'s asset id"));
+        }
+        return;
+    }
+
     // Check every real tx rollup proof has correct asset ids.
     for (size_t j = 0; j < NUM_ASSETS; j++) {
 
@@ -136,8 +158,23 @@ void check_bridge_call_datas_and_accumulate_defi_deposits(Composer& composer,
                                                           std::vector<field_ct>& defi_deposit_sums,
                                                           std::vector<field_ct> const& bridge_call_datas,
                                                           std::vector<field_ct> const& public_inputs,
-                                                          bool_ct const& is_real)
+                                                          bool_ct const& is_real,
+                                                          rollup::slot_lookup* bridge_call_data_lookup)
 {
+    gate_scope scope(composer, __FUNCTION__);
+    if (bridge_call_data_lookup) {
+        // Padding proofs have zeroed public inputs, so no bridge call datas.
+        for (size_t j = 0; j < NUM_BRIDGE_CALLS_PER_BLOCK; j++) {
+            auto inner_bridge_call_data = public_inputs[rollup::RollupProofFields::DEFI_BRIDGE_CALL_DATAS + j];
+            auto inner_defi_deposit_sum = public_inputs[rollup::RollupProofFields::DEFI_BRIDGE_DEPOSITS + j];
+            bridge_call_data_lookup->add(inner_bridge_call_data,
+                                         inner_defi_deposit_sum,
+                                         !inner_bridge_call_data.is_zero(),
+                                         format("rollup proof ", i, "'s bridge call data at index ", j));
+        }
+        return;
+    }
+
     // Check every real tx rollup proof has correct bridge call data.
     for (size_t j = 0; j < NUM_BRIDGE_CALLS_PER_BLOCK; j++) {
 
@@ -224,155 +261,221 @@ void assert_inner_proof_sequential(size_t const num_inner_txs_pow2,
     }
 }
 
-circuit_result_data root_rollup_circuit(Composer& composer,
-                                        root_rollup_tx const& tx,
-                                        size_t num_inner_txs_pow2,
-                                        size_t num_outer_txs_pow2,
-                                        std::shared_ptr<waffle::verification_key> const& inner_verification_key)
+root_rollup_circuit_builder::root_rollup_circuit_builder(
+    Composer& composer,
+    root_rollup_tx const& tx,
+    size_t num_inner_txs_pow2,
+    size_t num_outer_txs_pow2,
+    size_t max_num_inner_proofs,
+    std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+    rollup::SlotMatching slot_matching)
+    : composer_(composer)
+    , num_inner_txs_pow2_(num_inner_txs_pow2)
+    , num_outer_txs_pow2_(num_outer_txs_pow2)
+    , max_num_inner_proofs_(max_num_inner_proofs)
+    , inner_verification_key_(inner_verification_key)
+    , slot_matching_(slot_matching)
 {
-    auto max_num_inner_proofs = tx.rollups.size();
     ASSERT(max_num_inner_proofs <= num_outer_txs_pow2);
 
     // Witnesses.
-    const auto rollup_id = field_ct(witness_ct(&composer, tx.rollup_id));
-    const auto rollup_size_pow2 = field_ct(witness_ct(&composer, num_outer_txs_pow2));
-    rollup_size_pow2.assert_equal(num_outer_txs_pow2);
-    const auto num_inner_proofs = uint32_ct(witness_ct(&composer, tx.num_inner_proofs));
-    const auto old_root_root = field_ct(witness_ct(&composer, tx.old_data_roots_root));
-    const auto new_root_root = field_ct(witness_ct(&composer, tx.new_data_roots_root));
-    const auto old_root_path = create_witness_hash_path(composer, tx.old_data_roots_path);
-    const auto old_defi_root = field_ct(witness_ct(&composer, tx.old_defi_root));
-    const auto new_defi_root = field_ct(witness_ct(&composer, tx.new_defi_root));
-    const auto old_defi_path = create_witness_hash_path(composer, tx.old_defi_path);
-    const auto bridge_call_datas =
-        map(tx.bridge_call_datas, [&](auto& bid) { return field_ct(witness_ct(&composer, bid)); });
-    const auto asset_ids = map(tx.asset_ids, [&](auto& aid) { return field_ct(witness_ct(&composer, aid)); });
-    const auto defi_interaction_notes = map(tx.defi_interaction_notes, [&](auto n) {
+    rollup_id_ = field_ct(witness_ct(&composer, tx.rollup_id));
+    rollup_size_pow2_ = field_ct(witness_ct(&composer, num_outer_txs_pow2));
+    rollup_size_pow2_.assert_equal(num_outer_txs_pow2);
+    num_inner_proofs_ = uint32_ct(witness_ct(&composer, tx.num_inner_proofs));
+    old_root_root_ = field_ct(witness_ct(&composer, tx.old_data_roots_root));
+    new_root_root_ = field_ct(witness_ct(&composer, tx.new_data_roots_root));
+    old_root_path_ = create_witness_hash_path(composer, tx.old_data_roots_path);
+    old_defi_root_ = field_ct(witness_ct(&composer, tx.old_defi_root));
+    new_defi_root_ = field_ct(witness_ct(&composer, tx.new_defi_root));
+    old_defi_path_ = create_witness_hash_path(composer, tx.old_defi_path);
+    bridge_call_datas_ = map(tx.bridge_call_datas, [&](auto& bid) { return field_ct(witness_ct(&composer, bid)); });
+    asset_ids_ = map(tx.asset_ids, [&](auto& aid) { return field_ct(witness_ct(&composer, aid)); });
+    defi_interaction_notes_ = map(tx.defi_interaction_notes, [&](auto n) {
         return circuit::defi_interaction::note(circuit::defi_interaction::witness_data(composer, n));
     });
-    const auto num_previous_defi_interactions = field_ct(witness_ct(&composer, tx.num_previous_defi_interactions));
-    const auto recursive_manifest = Composer::create_unrolled_manifest(inner_verification_key->num_public_inputs);
-    const auto recursive_verification_key =
+    num_previous_defi_interactions_ = field_ct(witness_ct(&composer, tx.num_previous_defi_interactions));
+    recursive_verification_key_ =
         plonk::stdlib::recursion::verification_key<bn254>::from_constants(&composer, inner_verification_key);
-    field_ct rollup_beneficiary = field_ct(witness_ct(&composer, tx.rollup_beneficiary));
-    rollup_beneficiary.create_range_constraint(160, "rollup beneficiary is not an address!");
+    rollup_beneficiary_ = field_ct(witness_ct(&composer, tx.rollup_beneficiary));
+    rollup_beneficiary_.create_range_constraint(160, "rollup beneficiary is not an address!");
 
     // To be extracted from inner proofs.
-    field_ct data_start_index = witness_ct(&composer, 0);
-    field_ct old_data_root = witness_ct(&composer, 0);
-    field_ct new_data_root = witness_ct(&composer, 0);
-    field_ct old_null_root = witness_ct(&composer, 0);
-    field_ct new_null_root = witness_ct(&composer, 0);
+    data_start_index_ = witness_ct(&composer, 0);
+    old_data_root_ = witness_ct(&composer, 0);
+    new_data_root_ = witness_ct(&composer, 0);
+    old_null_root_ = witness_ct(&composer, 0);
+    new_null_root_ = witness_ct(&composer, 0);
 
     // A padding rollup uses the following as its public input hash.
-    field_ct zero_hash = compute_sha256_of_zeroes(composer, num_inner_txs_pow2);
+    zero_hash_ = compute_sha256_of_zeroes(composer, num_inner_txs_pow2);
 
     // Loop accumulators.
-    recursion_output<bn254> recursion_output;
-    std::vector<field_ct> inner_input_hashes;
-    std::vector<fr> tx_proof_public_inputs;
-    std::vector<field_ct> total_tx_fees(NUM_ASSETS, field_ct(witness_ct::create_constant_witness(&composer, 0)));
-    std::vector<field_ct> defi_deposit_sums(NUM_BRIDGE_CALLS_PER_BLOCK,
-                                            field_ct(witness_ct::create_constant_witness(&composer, 0)));
-
-    // Loop over each inner proof.
-    for (uint32_t i = 0; i < max_num_inner_proofs; ++i) {
-        auto is_real = num_inner_proofs > i;
-
-        recursion_output =
-            verify_proof<bn254, recursive_turbo_verifier_settings<bn254>>(&composer,
-                                                                          recursive_verification_key,
+    total_tx_fees_ = std::vector<field_ct>(NUM_ASSETS, field_ct(witness_ct::create_constant_witness(&composer, 0)));
+    defi_deposit_sums_ = std::vector<field_ct>(NUM_BRIDGE_CALLS_PER_BLOCK,
+                                               field_ct(witness_ct::create_constant_witness(&composer, 0)));
+
+    if (slot_matching_ == rollup::SlotMatching::LOOKUP) {
+        // Unused asset ids are padded with 2^{30} (NUM_MAX_ASSETS), and unused bridge call datas with zero.
+        asset_id_lookup_.emplace(
+            composer, asset_ids_, map(asset_ids_, [](auto const& a) { return a != field_ct(MAX_NUM_ASSETS); }));
+        asset_id_lookup_->assert_in_use_slots_distinct("asset ids are not distinct");
+        bridge_call_data_lookup_.emplace(
+            composer, bridge_call_datas_, map(bridge_call_datas_, [](auto const& b) { return !b.is_zero(); }));
+        bridge_call_data_lookup_->assert_in_use_slots_distinct("bridge call datas are not distinct");
+    }
+}
+
+void root_rollup_circuit_builder::add_inner_proof(std::vector<uint8_t> const& proof)
+{
+    ASSERT(num_inner_proofs_added_ < max_num_inner_proofs_);
+    auto& composer = composer_;
+    const auto i = static_cast<uint32_t>(num_inner_proofs_added_++);
+    auto is_real = num_inner_proofs_ > i;
+
+    const auto recursive_manifest = Composer::create_unrolled_manifest(inner_verification_key_->num_public_inputs);
+    {
+        gate_scope scope(composer, "verify_proof");
+        recursion_output_ =
+            verify_proof<bn254, recursive_inner_verifier_settings<bn254>>(&composer,
+                                                                          recursive_verification_key_,
                                                                           recursive_manifest,
-                                                                          waffle::plonk_proof{ tx.rollups[i] },
-                                                                          recursion_output);
+                                                                          waffle::plonk_proof{ proof },
+                                                                          recursion_output_);
+    }
 
-        auto& public_inputs = recursion_output.public_inputs;
+    auto& public_inputs = recursion_output_.public_inputs;
 
-        // Zero all public inputs for padding proofs.
-        for (auto& inp : public_inputs) {
-            inp *= is_real;
-        }
+    // Zero all public inputs for padding proofs.
+    for (auto& inp : public_inputs) {
+        inp *= is_real;
+    }
 
-        // Accumulate tx fees.
-        check_asset_ids_and_accumulate_tx_fees(composer, i, total_tx_fees, asset_ids, public_inputs, is_real);
-
-        // Accumulate defi deposits.
-        check_bridge_call_datas_and_accumulate_defi_deposits(
-            composer, i, defi_deposit_sums, bridge_call_datas, public_inputs, is_real);
-
-        assert_inner_proof_sequential(num_inner_txs_pow2,
-                                      i,
-                                      rollup_id,
-                                      data_start_index,
-                                      old_data_root,
-                                      new_data_root,
-                                      old_null_root,
-                                      new_null_root,
-                                      old_root_root,
-                                      new_defi_root,
-                                      public_inputs,
-                                      is_real);
-
-        field_ct hash =
-            field_ct::conditional_assign(is_real, public_inputs[rollup::RollupProofFields::INPUTS_HASH], zero_hash);
-        inner_input_hashes.push_back(hash);
-
-        // Accumulate tx public inputs.
-        for (size_t j = 0; j < rollup::PropagatedInnerProofFields::NUM_FIELDS * num_inner_txs_pow2; ++j) {
-            tx_proof_public_inputs.push_back(
-                public_inputs[rollup::RollupProofFields::INNER_PROOFS_DATA + j].get_value());
-        }
+    auto asset_id_lookup = asset_id_lookup_ ? &*asset_id_lookup_ : nullptr;
+    auto bridge_call_data_lookup = bridge_call_data_lookup_ ? &*bridge_call_data_lookup_ : nullptr;
+
+    // Accumulate tx fees.
+    check_asset_ids_and_accumulate_tx_fees(
+        composer, i, total_tx_fees_, asset_ids_, public_inputs, is_real, asset_id_lookup);
+
+    // Accumulate defi deposits.
+    check_bridge_call_datas_and_accumulate_defi_deposits(
+        composer, i, defi_deposit_sums_, bridge_call_datas_, public_inputs, is_real, bridge_call_data_lookup);
+
+    assert_inner_proof_sequential(num_inner_txs_pow2_,
+                                  i,
+                                  rollup_id_,
+                                  data_start_index_,
+                                  old_data_root_,
+                                  new_data_root_,
+                                  old_null_root_,
+                                  new_null_root_,
+                                  old_root_root_,
+                                  new_defi_root_,
+                                  public_inputs,
+                                  is_real);
+
+    field_ct hash =
+        field_ct::conditional_assign(is_real, public_inputs[rollup::RollupProofFields::INPUTS_HASH], zero_hash_);
+    inner_input_hashes_.push_back(hash);
+
+    // Accumulate tx public inputs.
+    for (size_t j = 0; j < rollup::PropagatedInnerProofFields::NUM_FIELDS * num_inner_txs_pow2_; ++j) {
+        tx_proof_public_inputs_.push_back(public_inputs[rollup::RollupProofFields::INNER_PROOFS_DATA + j].get_value());
     }
+}
+
+circuit_result_data root_rollup_circuit_builder::finalise()
+{
+    ASSERT(num_inner_proofs_added_ == max_num_inner_proofs_);
+    auto& composer = composer_;
 
     // Check defi interaction notes are inserted and computes previous_defi_interaction_hash.
     std::vector<field_ct> defi_interaction_note_commitments;
     auto previous_defi_interaction_hash = process_defi_interaction_notes(composer,
-                                                                         rollup_id,
-                                                                         new_defi_root,
-                                                                         old_defi_root,
-                                                                         old_defi_path,
-                                                                         num_previous_defi_interactions,
-                                                                         defi_interaction_notes,
+                                                                         rollup_id_,
+                                                                         new_defi_root_,
+                                                                         old_defi_root_,
+                                                                         old_defi_path_,
+                                                                         num_previous_defi_interactions_,
+                                                                         defi_interaction_notes_,
                                                                          defi_interaction_note_commitments);
 
     // Check data root tree is updated with latest data root.
-    check_root_tree_updated(old_root_path, rollup_id, new_data_root, new_root_root, old_root_root);
+    {
+        gate_scope scope(composer, "check_root_tree_updated");
+        check_root_tree_updated(old_root_path_, rollup_id_, new_data_root_, new_root_root_, old_root_root_);
+    }
+
+    if (slot_matching_ == rollup::SlotMatching::LOOKUP) {
+        // The recursion output commits to the public inputs of every inner proof. Which are padding depends on
+        // num_inner_proofs.
+        auto seed = rollup::recursion_output_seed(recursion_output_);
+        seed.push_back(field_ct(num_inner_proofs_));
+        total_tx_fees_ = asset_id_lookup_->finalise(seed, "rollup proof asset ids do not match the asset ids");
+        defi_deposit_sums_ = bridge_call_data_lookup_->finalise(
+            seed, "rollup proof bridge call datas do not match the bridge call datas");
+    }
 
     // Construct a list of header fields.
-    auto num_inner_proofs_pow2 = num_outer_txs_pow2 / num_inner_txs_pow2;
-    std::vector<field_ct> header_fields1 = { rollup_id,     rollup_size_pow2, data_start_index, old_data_root,
-                                             new_data_root, old_null_root,    new_null_root,    old_root_root,
-                                             new_root_root, old_defi_root,    new_defi_root };
+    auto num_inner_proofs_pow2 = num_outer_txs_pow2_ / num_inner_txs_pow2_;
+    std::vector<field_ct> header_fields1 = { rollup_id_,     rollup_size_pow2_, data_start_index_, old_data_root_,
+                                             new_data_root_, old_null_root_,    new_null_root_,    old_root_root_,
+                                             new_root_root_, old_defi_root_,    new_defi_root_ };
     std::vector<field_ct> header_fields2 = { previous_defi_interaction_hash,
-                                             rollup_beneficiary,
+                                             rollup_beneficiary_,
                                              num_inner_proofs_pow2 };
     auto header_fields = join({ header_fields1,
-                                bridge_call_datas,
-                                defi_deposit_sums,
-                                asset_ids,
-                                total_tx_fees,
+                                bridge_call_datas_,
+                                defi_deposit_sums_,
+                                asset_ids_,
+                                total_tx_fees_,
                                 defi_interaction_note_commitments,
                                 header_fields2 });
 
     // Construct hash of public inputs.
     // [ header fields ][ hashes of each inner rollups inputs ][ zero_hash padding ]
-    auto zero_hashes = std::vector<field_ct>(num_inner_proofs_pow2 - max_num_inner_proofs, zero_hash);
-    auto inputs_to_hash = join({ header_fields, inner_input_hashes, zero_hashes });
-    auto input_hash = stdlib::sha256_to_field(packed_byte_array_ct::from_field_element_vector(inputs_to_hash));
+    auto zero_hashes = std::vector<field_ct>(num_inner_proofs_pow2 - max_num_inner_proofs_, zero_hash_);
+    auto inputs_to_hash = join({ header_fields, inner_input_hashes_, zero_hashes });
+    field_ct input_hash;
+    {
+        gate_scope scope(composer, "sha256_to_field");
+        input_hash = stdlib::sha256_to_field(packed_byte_array_ct::from_field_element_vector(inputs_to_hash));
+    }
 
     // Construct list of fields to be broadcast along with proof.
     // [ header fields ][ public inputs of each tx ][ zero field padding ]
     std::vector<fr> header_fields_fr = map(header_fields, [](auto const& f) { return f.get_value(); });
-    size_t padding_rollups = num_inner_proofs_pow2 - max_num_inner_proofs;
-    size_t padding_txs = padding_rollups * num_inner_txs_pow2;
+    size_t padding_rollups = num_inner_proofs_pow2 - max_num_inner_proofs_;
+    size_t padding_txs = padding_rollups * num_inner_txs_pow2_;
     std::vector<fr> zero_padding(padding_txs * rollup::PropagatedInnerProofFields::NUM_FIELDS, fr(0));
-    std::vector<fr> broadcast_fields = join({ header_fields_fr, tx_proof_public_inputs, zero_padding });
+    std::vector<fr> broadcast_fields = join({ header_fields_fr, tx_proof_public_inputs_, zero_padding });
 
     // Set public inputs. Just the input hash and recursion elements.
     input_hash.set_public();
-    recursion_output.add_proof_outputs_as_public_inputs();
+    recursion_output_.add_proof_outputs_as_public_inputs();
 
-    return { recursion_output, broadcast_fields };
+    return { recursion_output_, broadcast_fields };
+}
+
+circuit_result_data root_rollup_circuit(Composer& composer,
+                                        root_rollup_tx const& tx,
+                                        size_t num_inner_txs_pow2,
+                                        size_t num_outer_txs_pow2,
+                                        std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+                                        rollup::SlotMatching slot_matching)
+{
+    root_rollup_circuit_builder builder(composer,
+                                        tx,
+                                        num_inner_txs_pow2,
+                                        num_outer_txs_pow2,
+                                        tx.rollups.size(),
+                                        inner_verification_key,
+                                        slot_matching);
+    for (auto const& proof : tx.rollups) {
+        builder.add_inner_proof(proof);
+    }
+    return builder.finalise();
 }
 
 } // namespace root_rollup
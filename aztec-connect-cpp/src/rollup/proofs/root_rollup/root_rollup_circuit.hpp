@@ -1,14 +1,17 @@
 #pragma once
 #include "./root_rollup_tx.hpp"
+#include "../notes/circuit/defi_interaction/note.hpp"
+#include "../rollup/rollup_circuit.hpp"
+#include "../circuit_types.hpp"
 #include <stdlib/recursion/verifier/program_settings.hpp>
 #include <stdlib/recursion/verifier/verifier.hpp>
-#include <stdlib/types/turbo.hpp>
+#include <optional>
 
 namespace rollup {
 namespace proofs {
 namespace root_rollup {
 
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 using namespace plonk::stdlib::recursion;
 
 struct circuit_result_data {
@@ -16,11 +19,83 @@ struct circuit_result_data {
     std::vector<fr> broadcast_data;
 };
 
+/**
+ * Builds the root rollup circuit one inner proof at a time, so that the per proof work (recursive verification and
+ * the checks on its public inputs) can be done as each inner proof becomes available.
+ * Gates are emitted in exactly the same order as a single call to `root_rollup_circuit`.
+ *
+ * `tx` provides everything but the inner proofs, which are given to `add_inner_proof` (including any padding proofs).
+ * `finalise` must be called once `max_num_inner_proofs` proofs have been added.
+ */
+class root_rollup_circuit_builder {
+  public:
+    root_rollup_circuit_builder(Composer& composer,
+                                root_rollup_tx const& tx,
+                                size_t num_inner_txs_pow2,
+                                size_t num_outer_txs_pow2,
+                                size_t max_num_inner_proofs,
+                                std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+                                rollup::SlotMatching slot_matching = rollup::SlotMatching::SCAN);
+
+    void add_inner_proof(std::vector<uint8_t> const& proof);
+
+    circuit_result_data finalise();
+
+    size_t num_inner_proofs_added() const { return num_inner_proofs_added_; }
+
+    // The aggregated recursion output of the inner proofs added so far.
+    recursion_output<bn254> const& get_recursion_output() const { return recursion_output_; }
+
+  private:
+    Composer& composer_;
+    size_t num_inner_txs_pow2_;
+    size_t num_outer_txs_pow2_;
+    size_t max_num_inner_proofs_;
+    size_t num_inner_proofs_added_ = 0;
+    std::shared_ptr<waffle::verification_key> inner_verification_key_;
+    rollup::SlotMatching slot_matching_;
+
+    field_ct rollup_id_;
+    field_ct rollup_size_pow2_;
+    uint32_ct num_inner_proofs_;
+    field_ct old_root_root_;
+    field_ct new_root_root_;
+    merkle_tree::hash_path old_root_path_;
+    field_ct old_defi_root_;
+    field_ct new_defi_root_;
+    merkle_tree::hash_path old_defi_path_;
+    std::vector<field_ct> bridge_call_datas_;
+    std::vector<field_ct> asset_ids_;
+    std::vector<notes::circuit::defi_interaction::note> defi_interaction_notes_;
+    field_ct num_previous_defi_interactions_;
+    std::shared_ptr<plonk::stdlib::recursion::verification_key<bn254>> recursive_verification_key_;
+    field_ct rollup_beneficiary_;
+
+    // To be extracted from inner proofs.
+    field_ct data_start_index_;
+    field_ct old_data_root_;
+    field_ct new_data_root_;
+    field_ct old_null_root_;
+    field_ct new_null_root_;
+
+    field_ct zero_hash_;
+
+    // Loop accumulators.
+    recursion_output<bn254> recursion_output_;
+    std::vector<field_ct> inner_input_hashes_;
+    std::vector<fr> tx_proof_public_inputs_;
+    std::vector<field_ct> total_tx_fees_;
+    std::vector<field_ct> defi_deposit_sums_;
+    std::optional<rollup::slot_lookup> asset_id_lookup_;
+    std::optional<rollup::slot_lookup> bridge_call_data_lookup_;
+};
+
 circuit_result_data root_rollup_circuit(Composer& composer,
                                         root_rollup_tx const& rollups,
                                         size_t inner_rollup_size,
                                         size_t outer_rollup_size,
-                                        std::shared_ptr<waffle::verification_key> const& inner_verification_key);
+                                        std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+                                        rollup::SlotMatching slot_matching = rollup::SlotMatching::SCAN);
 
 } // namespace root_rollup
 } // namespace proofs
@@ -0,0 +1,148 @@
+#include "root_rollup_session.hpp"
+#include "create_root_rollup_tx.hpp"
+#include "../circuit_types.hpp"
+
+namespace rollup {
+namespace proofs {
+namespace root_rollup {
+
+using namespace barretenberg;
+using namespace ::rollup::proofs::circuit_types;
+
+root_rollup_session::root_rollup_session(root_rollup_tx const& tx, circuit_data const& cd)
+    : cd_(cd)
+    , header_(tx)
+    , composer_(cd.proving_key, cd.verification_key, cd.num_gates)
+{
+    reserve_witness_capacity(composer_, cd);
+
+    if (!cd.inner_rollup_circuit_data.verification_key) {
+        err_ = "Inner verification key not provided.";
+        return;
+    }
+
+    if (cd.inner_rollup_circuit_data.padding_proof.size() == 0) {
+        err_ = "Inner padding proof not provided.";
+        return;
+    }
+
+    if (!cd.srs) {
+        err_ = "Srs not provided.";
+        return;
+    }
+
+    if (header_.num_inner_proofs > cd.num_inner_rollups) {
+        err_ = format("Too many inner proofs: ", header_.num_inner_proofs);
+        return;
+    }
+
+    // Pad only the header. Inner proofs arrive via `add`, and padding proofs are added in `finish`.
+    auto proofs = std::move(header_.rollups);
+    header_.rollups.clear();
+    pad_root_rollup_tx(header_, cd);
+    header_.rollups.clear();
+
+    builder_ = std::make_unique<root_rollup_circuit_builder>(composer_,
+                                                             header_,
+                                                             cd.inner_rollup_circuit_data.rollup_size,
+                                                             cd.rollup_size,
+                                                             cd.num_inner_rollups,
+                                                             cd.inner_rollup_circuit_data.verification_key,
+                                                             cd.slot_matching);
+
+    for (auto const& proof : proofs) {
+        if (!add(proof)) {
+            return;
+        }
+    }
+}
+
+bool root_rollup_session::add(std::vector<uint8_t> const& proof)
+{
+    if (failed()) {
+        return false;
+    }
+
+    if (num_added_ == header_.num_inner_proofs) {
+        err_ = "All inner proofs have already been added.";
+        info("root rollup session: ", err_);
+        return false;
+    }
+
+    Timer timer;
+    builder_->add_inner_proof(proof);
+    ++num_added_;
+
+    if (composer_.failed) {
+        err_ = composer_.err;
+        info("root rollup session: Circuit logic failed at inner proof ", num_added_ - 1, ": ", err_);
+        return false;
+    }
+
+    if (!pairing_check(builder_->get_recursion_output(), cd_.srs->get_verifier_crs())) {
+        err_ = format("Native pairing check failed at inner proof ", num_added_ - 1);
+        info("root rollup session: ", err_);
+        return false;
+    }
+
+    info("root rollup session: Added inner proof ", num_added_ - 1, " in ", timer.toString(), "s");
+    return true;
+}
+
+bool root_rollup_session::can_finish(verify_result& result) const
+{
+    if (failed()) {
+        result.err = err_;
+        return false;
+    }
+
+    if (num_added_ != header_.num_inner_proofs) {
+        result.err = format("Expected ", header_.num_inner_proofs, " inner proofs, got ", num_added_);
+        info("root rollup session: ", result.err);
+        return false;
+    }
+
+    return true;
+}
+
+verify_result root_rollup_session::build_remaining_circuit(circuit_data const& cd)
+{
+    // Only the padding proofs, the defi notes, the root tree update and the public input hash remain to be built.
+    while (builder_->num_inner_proofs_added() < cd.num_inner_rollups) {
+        builder_->add_inner_proof(cd.inner_rollup_circuit_data.padding_proof);
+    }
+    auto circuit_result = builder_->finalise();
+
+    verify_result result;
+    result.recursion_output = circuit_result.recursion_output;
+    result.broadcast_data = circuit_result.broadcast_data;
+    return result;
+}
+
+verify_result root_rollup_session::finish_logic()
+{
+    verify_result result;
+    if (!can_finish(result)) {
+        return result;
+    }
+    auto build_circuit = [&](Composer&, root_rollup_tx&, circuit_data const& cd) {
+        return build_remaining_circuit(cd);
+    };
+    return verify_logic_internal(composer_, header_, cd_, "root rollup", build_circuit);
+}
+
+verify_result root_rollup_session::finish()
+{
+    verify_result result;
+    if (!can_finish(result)) {
+        return result;
+    }
+    auto build_circuit = [&](Composer&, root_rollup_tx&, circuit_data const& cd) {
+        return build_remaining_circuit(cd);
+    };
+    return verify_internal(composer_, header_, cd_, "root rollup", true, build_circuit);
+}
+
+} // namespace root_rollup
+} // namespace proofs
+} // namespace rollup
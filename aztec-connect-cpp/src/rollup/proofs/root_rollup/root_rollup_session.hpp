@@ -0,0 +1,60 @@
+#pragma once
+#include "compute_circuit_data.hpp"
+#include "root_rollup_circuit.hpp"
+#include "root_rollup_tx.hpp"
+#include "verify.hpp"
+#include <memory>
+
+namespace rollup {
+namespace proofs {
+namespace root_rollup {
+
+/**
+ * Builds a root rollup while its inner rollup proofs are still being produced.
+ *
+ * Each proof given to `add` is recursively verified into the circuit straight away, followed by a native pairing
+ * check of the aggregated recursion output, so a bad inner proof is rejected on arrival rather than at the end.
+ * `finish` (or `finish_logic`) then only pads the remaining slots, completes the circuit and proves it.
+ *
+ * `tx` is the root rollup header, as it would be passed to `verify`. Any proofs already in `tx.rollups` are added
+ * on construction. Once `add` has failed the session cannot be finished, as the circuit can't be unwound.
+ *
+ * The session keeps its own copy of `cd`, sharing its keys, so it outlives the caller purging or replacing theirs.
+ */
+class root_rollup_session {
+  public:
+    root_rollup_session(root_rollup_tx const& tx, circuit_data const& cd);
+
+    root_rollup_session(root_rollup_session const&) = delete;
+    root_rollup_session& operator=(root_rollup_session const&) = delete;
+
+    bool add(std::vector<uint8_t> const& proof);
+
+    // Completes the circuit without proving it, as `verify_logic` would.
+    verify_result finish_logic();
+
+    // Completes and proves the circuit, as `verify` would.
+    verify_result finish();
+
+    size_t num_added() const { return num_added_; }
+
+    bool failed() const { return !err_.empty(); }
+
+    std::string const& err() const { return err_; }
+
+  private:
+    bool can_finish(verify_result& result) const;
+
+    verify_result build_remaining_circuit(circuit_data const& cd);
+
+    circuit_data cd_;
+    root_rollup_tx header_;
+    Composer composer_;
+    std::unique_ptr<root_rollup_circuit_builder> builder_;
+    size_t num_added_ = 0;
+    std::string err_;
+};
+
+} // namespace root_rollup
+} // namespace proofs
+} // namespace rollup
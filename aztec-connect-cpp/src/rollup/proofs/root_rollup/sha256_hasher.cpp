@@ -0,0 +1,94 @@
+#include "sha256_hasher.hpp"
+#include <common/serialize.hpp>
+#include <crypto/sha256/sha256.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace rollup {
+namespace proofs {
+namespace root_rollup {
+
+sha256_hasher::sha256_hasher()
+{
+    sha256::prepare_constants(state_);
+}
+
+// Only buffering and padding live here: each block is compressed by barretenberg's sha256.
+void sha256_hasher::compress(uint8_t const* block)
+{
+    std::array<uint32_t, 16> words;
+    for (size_t i = 0; i < 16; ++i) {
+        words[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+                   (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+    }
+    state_ = sha256::sha256_block(state_, words);
+}
+
+void sha256_hasher::update(uint8_t const* data, size_t length)
+{
+    total_length_ += length;
+
+    if (block_length_) {
+        auto n = std::min(length, block_.size() - block_length_);
+        std::memcpy(block_.data() + block_length_, data, n);
+        block_length_ += n;
+        data += n;
+        length -= n;
+        if (block_length_ < block_.size()) {
+            return;
+        }
+        compress(block_.data());
+        block_length_ = 0;
+    }
+
+    // Whole blocks are compressed straight out of the caller's buffer.
+    for (; length >= block_.size(); data += block_.size(), length -= block_.size()) {
+        compress(data);
+    }
+
+    std::memcpy(block_.data(), data, length);
+    block_length_ = length;
+}
+
+void sha256_hasher::update(barretenberg::fr const& field)
+{
+    std::array<uint8_t, 32> buf;
+    barretenberg::fr::serialize_to_buffer(field, buf.data());
+    update(buf.data(), buf.size());
+}
+
+std::array<uint8_t, 32> sha256_hasher::finalize()
+{
+    uint64_t bit_length = total_length_ * 8;
+
+    block_[block_length_++] = 0x80;
+    if (block_length_ > block_.size() - 8) {
+        std::fill(block_.begin() + static_cast<std::ptrdiff_t>(block_length_), block_.end(), 0);
+        compress(block_.data());
+        block_length_ = 0;
+    }
+    std::fill(block_.begin() + static_cast<std::ptrdiff_t>(block_length_), block_.end() - 8, 0);
+    for (size_t i = 0; i < 8; ++i) {
+        block_[block_.size() - 1 - i] = static_cast<uint8_t>(bit_length >> (i * 8));
+    }
+    compress(block_.data());
+
+    std::array<uint8_t, 32> result;
+    for (size_t i = 0; i < 8; ++i) {
+        result[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+        result[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        result[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        result[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+    }
+    return result;
+}
+
+barretenberg::fr sha256_hasher::finalize_to_field()
+{
+    auto result = finalize();
+    return from_buffer<barretenberg::fr>(result.data());
+}
+
+} // namespace root_rollup
+} // namespace proofs
+} // namespace rollup
@@ -0,0 +1,42 @@
+#pragma once
+#include <ecc/curves/bn254/fr.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rollup {
+namespace proofs {
+namespace root_rollup {
+
+/**
+ * An incremental SHA-256, so that large inputs (e.g. the broadcast data of a full root rollup) can be hashed
+ * field by field, without first serializing them into one contiguous buffer.
+ * Produces the same digest as `sha256::sha256` over the concatenation of all updates, compressing each block with
+ * barretenberg's `sha256::sha256_block`.
+ */
+class sha256_hasher {
+  public:
+    sha256_hasher();
+
+    void update(uint8_t const* data, size_t length);
+
+    // Absorbs a field in its 32 byte big-endian serialized form, as written by `write(buf, fr)`.
+    void update(barretenberg::fr const& field);
+
+    std::array<uint8_t, 32> finalize();
+
+    // Equivalent to `sha256::sha256_to_field` over all updates.
+    barretenberg::fr finalize_to_field();
+
+  private:
+    void compress(uint8_t const* block);
+
+    std::array<uint32_t, 8> state_;
+    std::array<uint8_t, 64> block_;
+    size_t block_length_ = 0;
+    uint64_t total_length_ = 0;
+};
+
+} // namespace root_rollup
+} // namespace proofs
+} // namespace rollup
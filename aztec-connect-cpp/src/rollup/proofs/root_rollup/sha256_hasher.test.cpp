@@ -0,0 +1,43 @@
+#include "sha256_hasher.hpp"
+#include <crypto/sha256/sha256.hpp>
+#include <numeric/random/engine.hpp>
+#include <gtest/gtest.h>
+
+using namespace barretenberg;
+using namespace rollup::proofs::root_rollup;
+
+namespace {
+auto& rand_engine = numeric::random::get_debug_engine();
+}
+
+TEST(root_rollup_sha256_hasher, matches_one_shot_sha256)
+{
+    // Cover lengths either side of the padding boundary and of whole blocks.
+    for (size_t length : { 0UL, 1UL, 55UL, 56UL, 63UL, 64UL, 65UL, 119UL, 128UL, 1000UL }) {
+        std::vector<uint8_t> input(length);
+        for (auto& byte : input) {
+            byte = static_cast<uint8_t>(rand_engine.get_random_uint32());
+        }
+
+        // Feed the input in irregular chunks.
+        sha256_hasher hasher;
+        for (size_t i = 0, chunk = 1; i < length; i += chunk, chunk = chunk * 3 + 1) {
+            hasher.update(input.data() + i, std::min(chunk, length - i));
+        }
+
+        EXPECT_EQ(hasher.finalize(), sha256::sha256(input));
+    }
+}
+
+TEST(root_rollup_sha256_hasher, field_updates_match_sha256_to_field)
+{
+    std::vector<uint8_t> buf;
+    sha256_hasher hasher;
+    for (size_t i = 0; i < 5; ++i) {
+        auto field = fr::random_element(&rand_engine);
+        write(buf, field);
+        hasher.update(field);
+    }
+
+    EXPECT_EQ(hasher.finalize_to_field(), sha256::sha256_to_field(buf));
+}
@@ -1,13 +1,14 @@
 #include "./verify.hpp"
 #include "create_root_rollup_tx.hpp"
 #include "./root_rollup_circuit.hpp"
+#include "../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace root_rollup {
 
 using namespace barretenberg;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 namespace {
 verify_result build_circuit(Composer& composer, root_rollup_tx& tx, circuit_data const& circuit_data)
@@ -31,7 +32,8 @@ verify_result build_circuit(Composer& composer, root_rollup_tx& tx, circuit_data
                                               tx,
                                               circuit_data.inner_rollup_circuit_data.rollup_size,
                                               circuit_data.rollup_size,
-                                              circuit_data.inner_rollup_circuit_data.verification_key);
+                                              circuit_data.inner_rollup_circuit_data.verification_key,
+                                              circuit_data.slot_matching);
 
     result.recursion_output = circuit_result.recursion_output;
     result.broadcast_data = circuit_result.broadcast_data;
@@ -43,12 +45,14 @@ verify_result build_circuit(Composer& composer, root_rollup_tx& tx, circuit_data
 verify_result verify_logic(root_rollup_tx& tx, circuit_data const& cd)
 {
     Composer composer = Composer(cd.proving_key, cd.verification_key, cd.num_gates);
+    reserve_witness_capacity(composer, cd);
     return verify_logic_internal(composer, tx, cd, "root rollup", build_circuit);
 }
 
 verify_result verify(root_rollup_tx& tx, circuit_data const& cd)
 {
     Composer composer = Composer(cd.proving_key, cd.verification_key, cd.num_gates);
+    reserve_witness_capacity(composer, cd);
     return verify_internal(composer, tx, cd, "root rollup", true, build_circuit);
 }
 
@@ -2,13 +2,14 @@
 #include "../verify.hpp"
 #include "compute_circuit_data.hpp"
 #include "root_rollup_tx.hpp"
+#include "../circuit_types.hpp"
 
 namespace rollup {
 namespace proofs {
 namespace root_rollup {
 
 using namespace barretenberg;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 
 struct verify_result : ::rollup::proofs::verify_result<Composer> {
     std::vector<fr> broadcast_data;
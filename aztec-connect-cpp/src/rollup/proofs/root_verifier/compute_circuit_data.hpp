@@ -1,6 +1,7 @@
 #pragma once
 #include "../root_rollup/compute_circuit_data.hpp"
 #include "root_verifier_circuit.hpp"
+#include <algorithm>
 
 namespace rollup {
 namespace proofs {
@@ -10,6 +11,43 @@ struct circuit_data : proofs::circuit_data {
     std::vector<std::shared_ptr<waffle::verification_key>> valid_vks;
 };
 
+/**
+ * The root rollup circuits, as {txs per inner rollup, inner rollups}, that a root verifier over the given sizes
+ * accepts proofs from: every pairing, ascending. The root verifier circuit, and so its vk, depends on the order of its
+ * valid vks, so keygen and rollup_cli both derive them from this.
+ */
+inline std::vector<std::pair<size_t, size_t>> get_valid_root_rollup_sizes(std::vector<size_t> txs_per_inner,
+                                                                          std::vector<size_t> inners_per_root)
+{
+    for (auto* sizes : { &txs_per_inner, &inners_per_root }) {
+        std::sort(sizes->begin(), sizes->end());
+        sizes->erase(std::unique(sizes->begin(), sizes->end()), sizes->end());
+    }
+    std::vector<std::pair<size_t, size_t>> result;
+    for (auto num_txs : txs_per_inner) {
+        for (auto num_rollups : inners_per_root) {
+            result.emplace_back(num_txs, num_rollups);
+        }
+    }
+    return result;
+}
+
+// Identifies a set of valid vks, in order, so root verifiers over different sets don't share a key name.
+inline std::string get_valid_vks_id(std::vector<std::shared_ptr<waffle::verification_key>> const& valid_vks)
+{
+    using serialize::write;
+    std::vector<uint8_t> buf;
+    for (auto const& vk : valid_vks) {
+        write(buf, vk ? to_buffer(*vk) : std::vector<uint8_t>());
+    }
+    auto hash = sha256::sha256(buf);
+    std::ostringstream os;
+    for (size_t i = 0; i < 4; ++i) {
+        os << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+    }
+    return os.str();
+}
+
 inline circuit_data get_circuit_data(root_rollup::circuit_data const& root_rollup_circuit_data,
                                      std::shared_ptr<waffle::ReferenceStringFactory> const& srs,
                                      std::vector<std::shared_ptr<waffle::verification_key>> const& valid_vks,
@@ -23,8 +61,7 @@ inline circuit_data get_circuit_data(root_rollup::circuit_data const& root_rollu
 {
     std::cerr << "Getting root verifier circuit data: (size: " << root_rollup_circuit_data.rollup_size << ")"
               << std::endl;
-    auto name =
-        format("root_verifier_", root_rollup_circuit_data.inner_rollup_circuit_data.rollup_size, "_", valid_vks.size());
+    auto name = format("root_verifier_", valid_vks.size(), "_", get_valid_vks_id(valid_vks));
 
     auto build_verifier_circuit = [&](OuterComposer& composer) {
         root_verifier_tx tx;
@@ -46,10 +83,12 @@ inline circuit_data get_circuit_data(root_rollup::circuit_data const& root_rollu
         false,
         mock,
         build_verifier_circuit,
-        format(" ", root_rollup_circuit_data.inner_rollup_circuit_data.rollup_size, "x", valid_vks.size()));
+        format(" ", root_rollup_circuit_data.inner_rollup_circuit_data.rollup_size, "x", valid_vks.size()),
+        valid_vks);
 
     circuit_data data;
     data.num_gates = cd.num_gates;
+    data.shape = cd.shape;
     data.srs = cd.srs;
     data.proving_key = cd.proving_key;
     data.verification_key = cd.verification_key;
@@ -1,6 +1,8 @@
 #pragma once
 #include <common/container.hpp>
+#include <common/throw_or_abort.hpp>
 #include "../root_rollup/root_rollup_broadcast_data.hpp"
+#include "../root_rollup/root_rollup_broadcast_view.hpp"
 #include "../root_rollup/verify.hpp"
 #include "verify.hpp"
 
@@ -12,27 +14,39 @@ inline root_verifier_tx create_root_verifier_tx(root_rollup::verify_result const
 {
     root_verifier_tx tx;
 
-    root_rollup::root_rollup_broadcast_data broadcast_data(result.broadcast_data);
-
-    tx.broadcast_data = to_buffer(broadcast_data);
+    // Serialize the broadcast fields directly, rather than via an intermediate root_rollup_broadcast_data.
+    root_rollup::write_broadcast_fields(tx.broadcast_data, result.broadcast_data);
     tx.proof_data = result.proof_data;
     return tx;
 }
 
-inline root_verifier_tx create_root_verifier_tx(std::vector<uint8_t> proof_buf, size_t rollup_size)
+inline root_verifier_tx create_root_verifier_tx(std::vector<uint8_t> const& proof_buf, size_t rollup_size)
 {
     root_verifier_tx tx;
 
     size_t broadcast_data_byte_len = 32 * (root_rollup::RootRollupBroadcastFields::INNER_PROOFS_DATA +
                                            rollup_size * rollup::PropagatedInnerProofFields::NUM_FIELDS);
-    std::vector<uint8_t> broadcast_data(slice(proof_buf, 0, broadcast_data_byte_len));
-    std::vector<uint8_t> root_rollup_proof(slice(proof_buf, broadcast_data_byte_len, proof_buf.size()));
-
-    tx.broadcast_data = broadcast_data;
-    tx.proof_data = root_rollup_proof;
+    if (proof_buf.size() < broadcast_data_byte_len) {
+        throw_or_abort(format("Root rollup proof buffer of ", proof_buf.size(), " bytes is too short."));
+    }
+
+    // Copy each part of the buffer exactly once, straight into the tx.
+    auto split = proof_buf.begin() + static_cast<std::ptrdiff_t>(broadcast_data_byte_len);
+    tx.broadcast_data.assign(proof_buf.begin(), split);
+    tx.proof_data.assign(split, proof_buf.end());
     return tx;
 }
 
+// As above, with the rollup size read from the broadcast data itself.
+inline root_verifier_tx create_root_verifier_tx(std::vector<uint8_t> const& proof_buf)
+{
+    if (proof_buf.size() < root_rollup::root_rollup_broadcast_view::HEADER_SIZE) {
+        throw_or_abort(format("Root rollup proof buffer of ", proof_buf.size(), " bytes is too short."));
+    }
+    auto rollup_size = root_rollup::root_rollup_broadcast_view(proof_buf).rollup_size_u32();
+    return create_root_verifier_tx(proof_buf, rollup_size);
+}
+
 } // namespace root_verifier
 } // namespace proofs
 } // namespace rollup
@@ -57,9 +57,9 @@ class root_verifier_tests : public ::testing::Test {
         std::filesystem::create_directories(TEST_PROOFS_PATH);
         srs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(CRS_PATH);
 
-        account_cd = proofs::account::get_circuit_data(srs);
-        js_cd = join_split::get_circuit_data(srs);
-        claim_cd = proofs::claim::get_circuit_data(srs);
+        account_cd = proofs::account::get_circuit_data(srs, false, FIXTURE_PATH, true, persist, persist);
+        js_cd = join_split::get_circuit_data(srs, false, FIXTURE_PATH, true, persist, persist);
+        claim_cd = proofs::claim::get_circuit_data(srs, false, FIXTURE_PATH, true, persist, persist);
 
         if (recreate) {
             tx_rollup_cd =
@@ -121,6 +121,17 @@ TEST_F(root_verifier_tests, passing)
     ASSERT_TRUE(result.logic_verified);
 }
 
+TEST_F(root_verifier_tests, prepared_circuit_matches)
+{
+    root_verifier_tx tx_data = create_root_verifier_tx();
+    auto prepared = prepare_circuit(root_verifier_cd, root_rollup_cd);
+    auto prepared_result = verify_logic(*prepared, tx_data, root_verifier_cd, root_rollup_cd);
+    auto result = verify_logic(tx_data, root_verifier_cd, root_rollup_cd);
+    ASSERT_TRUE(prepared_result.logic_verified);
+    EXPECT_EQ(prepared_result.public_inputs, result.public_inputs);
+    EXPECT_EQ(prepared_result.number_of_gates, result.number_of_gates);
+}
+
 TEST_F(root_verifier_tests, failing_invalid_shape)
 {
     root_verifier_tx tx_data = create_root_verifier_tx();
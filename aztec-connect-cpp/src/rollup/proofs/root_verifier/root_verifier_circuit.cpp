@@ -7,22 +7,34 @@ namespace root_verifier {
 using namespace plonk;
 using namespace plonk::stdlib::recursion;
 
-recursion_output<outer_curve> root_verifier_circuit(
+std::shared_ptr<verification_key_pt> create_root_verifier_key(
     OuterComposer& composer,
-    root_verifier_tx const& tx,
     std::shared_ptr<waffle::verification_key> const& inner_verification_key,
     std::vector<std::shared_ptr<waffle::verification_key>> const& valid_vks)
 {
-    recursion_output<outer_curve> recursion_output;
     if (!valid_vks.size()) {
         composer.failed = true;
         composer.err = "Cannot build root verifier circuit with empty list of keys.";
-        return recursion_output;
+        return nullptr;
     }
 
-    auto recursive_manifest = InnerComposer::create_unrolled_manifest(inner_verification_key->num_public_inputs);
     auto recursive_verification_key = verification_key_pt::from_witness(&composer, inner_verification_key);
     recursive_verification_key->validate_key_is_in_set(valid_vks);
+    return recursive_verification_key;
+}
+
+recursion_output<outer_curve> complete_root_verifier_circuit(
+    OuterComposer& composer,
+    root_verifier_tx const& tx,
+    std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+    std::shared_ptr<verification_key_pt> const& recursive_verification_key)
+{
+    recursion_output<outer_curve> recursion_output;
+    if (!recursive_verification_key) {
+        return recursion_output;
+    }
+
+    auto recursive_manifest = InnerComposer::create_unrolled_manifest(inner_verification_key->num_public_inputs);
     recursion_output = verify_proof<outer_curve, recursive_settings>(&composer,
                                                                      recursive_verification_key,
                                                                      recursive_manifest,
@@ -36,6 +48,16 @@ recursion_output<outer_curve> root_verifier_circuit(
     return recursion_output;
 }
 
+recursion_output<outer_curve> root_verifier_circuit(
+    OuterComposer& composer,
+    root_verifier_tx const& tx,
+    std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+    std::vector<std::shared_ptr<waffle::verification_key>> const& valid_vks)
+{
+    auto recursive_verification_key = create_root_verifier_key(composer, inner_verification_key, valid_vks);
+    return complete_root_verifier_circuit(composer, tx, inner_verification_key, recursive_verification_key);
+}
+
 } // namespace root_verifier
 } // namespace proofs
 } // namespace rollup
@@ -1,5 +1,6 @@
 #pragma once
 #include "./root_verifier_tx.hpp"
+#include "../circuit_types.hpp"
 #include <stdlib/recursion/verifier/program_settings.hpp>
 #include <stdlib/recursion/verifier/verifier.hpp>
 
@@ -9,19 +10,35 @@ namespace root_verifier {
 
 using namespace plonk;
 
-using InnerComposer = waffle::TurboComposer;
+using InnerComposer = circuit_types::Composer;
 using OuterComposer = waffle::StandardComposer;
 
 typedef stdlib::bn254<OuterComposer> outer_curve;
 
 typedef stdlib::recursion::verification_key<outer_curve> verification_key_pt;
-typedef stdlib::recursion::recursive_turbo_verifier_settings<outer_curve> recursive_settings;
+typedef circuit_types::recursive_inner_verifier_settings<outer_curve> recursive_settings;
 
 struct circuit_outputs {
     stdlib::recursion::recursion_output<outer_curve> recursion_output;
     std::shared_ptr<verification_key_pt> verification_key;
 };
 
+/**
+ * The root verifier circuit is built in two parts, so that the first can be built before the root rollup proof exists.
+ * `create_root_verifier_key` adds the root rollup vk as a witness and checks it is one of `valid_vks`.
+ * `complete_root_verifier_circuit` then recursively verifies the proof against that key.
+ */
+std::shared_ptr<verification_key_pt> create_root_verifier_key(
+    OuterComposer& composer,
+    std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+    std::vector<std::shared_ptr<waffle::verification_key>> const& valid_vks);
+
+stdlib::recursion::recursion_output<outer_curve> complete_root_verifier_circuit(
+    OuterComposer& composer,
+    root_verifier_tx const& tx,
+    std::shared_ptr<waffle::verification_key> const& inner_verification_key,
+    std::shared_ptr<verification_key_pt> const& recursive_verification_key);
+
 stdlib::recursion::recursion_output<outer_curve> root_verifier_circuit(
     OuterComposer& composer,
     root_verifier_tx const& tx,
@@ -95,7 +95,8 @@ HEAVY_TEST_F(root_verifier_full_tests, good_data_passes_and_detect_circuit_chang
     // If the below assertions fail, consider changing the variable is_circuit_change_expected to 1 in
     // rollup/constants.hpp and see if atleast the next power of two limit is not exceeded. Please change the constant
     // values accordingly and set is_circuit_change_expected to 0 in rollup/constants.hpp before merging.
-    if (!(circuit_gate_count::is_circuit_change_expected)) {
+    // The recorded counts and hashes are of the turbo circuits, so other composers only check the power of two limit.
+    if (!(circuit_gate_count::is_circuit_change_expected) && circuit_types::is_reference_composer) {
         EXPECT_EQ(number_of_gates_root_verifier, circuit_gate_count::ROOT_VERIFIER)
             << "The gate count for the root verifier circuit is changed.";
         EXPECT_EQ(from_buffer<uint256_t>(vk_hash_root_verifier), circuit_vk_hash::ROOT_VERIFIER)
@@ -26,6 +26,7 @@ verify_result<OuterComposer> verify_logic(root_verifier_tx& tx,
                                           root_rollup::circuit_data const& root_rollup_cd)
 {
     OuterComposer composer = OuterComposer(cd.proving_key, cd.verification_key, cd.num_gates);
+    reserve_witness_capacity(composer, cd);
     return verify_logic_internal(
         composer, tx, cd, "root verifier", [&](OuterComposer& composer, root_verifier_tx& tx, circuit_data const& cd) {
             return build_circuit(composer, tx, cd, root_rollup_cd);
@@ -37,6 +38,7 @@ verify_result<OuterComposer> verify(root_verifier_tx& tx,
                                     root_rollup::circuit_data const& root_rollup_cd)
 {
     OuterComposer composer = OuterComposer(cd.proving_key, cd.verification_key, cd.num_gates);
+    reserve_witness_capacity(composer, cd);
     return verify_internal(composer,
                            tx,
                            cd,
@@ -47,6 +49,60 @@ verify_result<OuterComposer> verify(root_verifier_tx& tx,
                            });
 }
 
+std::unique_ptr<prepared_circuit> prepare_circuit(circuit_data const& cd,
+                                                  root_rollup::circuit_data const& root_rollup_cd)
+{
+    auto prepared = std::make_unique<prepared_circuit>(cd);
+    reserve_witness_capacity(prepared->composer, cd);
+    if (root_rollup_cd.verification_key) {
+        prepared->recursive_verification_key =
+            create_root_verifier_key(prepared->composer, root_rollup_cd.verification_key, cd.valid_vks);
+    }
+    return prepared;
+}
+
+verify_result<OuterComposer> build_prepared_circuit(prepared_circuit& prepared,
+                                                    root_verifier_tx& tx,
+                                                    root_rollup::circuit_data const& root_rollup_cd)
+{
+    verify_result<OuterComposer> result;
+
+    if (!root_rollup_cd.verification_key) {
+        info("Inner verification key not provided.");
+        return result;
+    }
+
+    result.recursion_output = complete_root_verifier_circuit(
+        prepared.composer, tx, root_rollup_cd.verification_key, prepared.recursive_verification_key);
+    return result;
+}
+
+verify_result<OuterComposer> verify_logic(prepared_circuit& prepared,
+                                          root_verifier_tx& tx,
+                                          circuit_data const& cd,
+                                          root_rollup::circuit_data const& root_rollup_cd)
+{
+    return verify_logic_internal(
+        prepared.composer, tx, cd, "root verifier", [&](OuterComposer&, root_verifier_tx& tx, circuit_data const&) {
+            return build_prepared_circuit(prepared, tx, root_rollup_cd);
+        });
+}
+
+verify_result<OuterComposer> verify(prepared_circuit& prepared,
+                                    root_verifier_tx& tx,
+                                    circuit_data const& cd,
+                                    root_rollup::circuit_data const& root_rollup_cd)
+{
+    return verify_internal(prepared.composer,
+                           tx,
+                           cd,
+                           "root verifier",
+                           false,
+                           [&](OuterComposer&, root_verifier_tx& tx, circuit_data const&) {
+                               return build_prepared_circuit(prepared, tx, root_rollup_cd);
+                           });
+}
+
 } // namespace root_verifier
 } // namespace proofs
 } // namespace rollup
\ No newline at end of file
@@ -7,6 +7,22 @@ namespace rollup {
 namespace proofs {
 namespace root_verifier {
 
+/**
+ * A root verifier composer with the part of the circuit that doesn't depend on the root rollup proof already built.
+ * Lets the root verifier be prepared while the root rollup proof it will verify is still being created.
+ */
+struct prepared_circuit {
+    prepared_circuit(circuit_data const& cd)
+        : composer(cd.proving_key, cd.verification_key, cd.num_gates)
+    {}
+
+    OuterComposer composer;
+    std::shared_ptr<verification_key_pt> recursive_verification_key;
+};
+
+std::unique_ptr<prepared_circuit> prepare_circuit(circuit_data const& circuit_data,
+                                                  root_rollup::circuit_data const& root_rollup_cd);
+
 verify_result<OuterComposer> verify_logic(root_verifier_tx& tx,
                                           circuit_data const& circuit_data,
                                           root_rollup::circuit_data const& root_rollup_cd);
@@ -15,6 +31,17 @@ verify_result<OuterComposer> verify(root_verifier_tx& tx,
                                     circuit_data const& circuit_data,
                                     root_rollup::circuit_data const& root_rollup_cd);
 
+// As `verify_logic` and `verify`, completing a circuit from `prepare_circuit` with the same circuit data.
+verify_result<OuterComposer> verify_logic(prepared_circuit& prepared,
+                                          root_verifier_tx& tx,
+                                          circuit_data const& circuit_data,
+                                          root_rollup::circuit_data const& root_rollup_cd);
+
+verify_result<OuterComposer> verify(prepared_circuit& prepared,
+                                    root_verifier_tx& tx,
+                                    circuit_data const& circuit_data,
+                                    root_rollup::circuit_data const& root_rollup_cd);
+
 } // namespace root_verifier
 } // namespace proofs
 } // namespace rollup
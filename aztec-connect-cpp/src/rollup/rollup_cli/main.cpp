@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <future>
+#include <map>
 #include <sstream>
 #include <iostream>
 
@@ -13,13 +16,15 @@
 #include "../proofs/rollup/index.hpp"
 #include "../proofs/root_rollup/index.hpp"
 #include "../proofs/root_verifier/index.hpp"
+#include "../proofs/mapped_reference_string_factory.hpp"
+#include "startup_graph.hpp"
 #include <common/timer.hpp>
 #include <common/container.hpp>
 #include <common/map.hpp>
 
-#include <plonk/composer/turbo/compute_verification_key.hpp>
 #include <plonk/proof_system/proving_key/proving_key.hpp>
 #include <plonk/proof_system/verification_key/verification_key.hpp>
+#include <plonk/proof_system/verifier/verifier.hpp>
 
 using namespace ::rollup::proofs;
 using namespace plonk::stdlib::merkle_tree;
@@ -27,54 +32,182 @@ using namespace serialize;
 namespace tx_rollup = ::rollup::proofs::rollup;
 
 namespace {
-// Number of transactions in an inner rollup.
-size_t txs_per_inner;
-// Number of inner rollups in a root rollup.
-size_t inners_per_root;
+// Valid numbers of transactions in an inner rollup, ascending.
+std::vector<size_t> txs_per_inner;
+// Valid numbers of inner rollups in a root rollup, ascending.
+std::vector<size_t> inners_per_root;
 // In mock mode, mock proofs (expected public inputs, but no constraints) are generated.
 bool mock_proofs;
 // Create big circuits proving keys lazily to improve startup times.
 bool lazy_init;
-// True if rollup circuit data (proving and verification keys) are to be persisted to disk.
+// True if circuit data (proving and verification keys) are to be persisted to disk.
 // We likely don't have enough memory to hold all keys in memory, and loading keys from disk is faster.
 bool persist;
 // Path to save proving keys to if persist is on.
 std::string data_path;
-
-std::shared_ptr<waffle::DynamicFileReferenceStringFactory> crs;
+// Most circuits to build or load keys for at once, at startup.
+size_t max_startup_jobs;
+// Build every circuit before using its persisted keys, rather than loading the keys of the circuit as last built.
+// Persisted verification keys and padding proofs are otherwise loaded without building their circuits, which can't
+// tell that a circuit has changed, so this must be set on the first run after changing any circuit.
+bool rebuild;
+
+std::shared_ptr<waffle::ReferenceStringFactory> crs;
 join_split::circuit_data js_cd;
 account::circuit_data account_cd;
 claim::circuit_data claim_cd;
-tx_rollup::circuit_data tx_rollup_cd;
-root_rollup::circuit_data root_rollup_cd;
+// Keyed by number of txs in an inner rollup.
+std::map<size_t, tx_rollup::circuit_data> tx_rollup_cds;
+// Keyed by number of txs in an inner rollup, then number of inner rollups in a root rollup.
+std::map<std::pair<size_t, size_t>, root_rollup::circuit_data> root_rollup_cds;
 root_verifier::circuit_data root_verifier_cd;
+// Root rollup being built as its inner proofs arrive, if any.
+std::unique_ptr<root_rollup::root_rollup_session> root_rollup_session;
+// The circuit sizes of the block being rolled up. Its inner rollups are all padded to the size the first fixes.
+root_rollup::block_sizes block;
 } // namespace
 
-// Postcondition: tx_rollup_cd has a proving key and verification key.
-void init_tx_rollup(size_t num_txs)
+std::vector<size_t> parse_sizes(std::string const& sizes_raw)
+{
+    std::vector<size_t> sizes;
+    std::istringstream is(sizes_raw);
+    std::string size;
+    while (std::getline(is, size, ',')) {
+        sizes.emplace_back(std::stoul(size));
+    }
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    return sizes;
+}
+
+// In lazy init mode we conserve memory by holding at most one tx or root rollup proving key at a time.
+void purge_rollup_proving_keys()
 {
+    info("Purging rollup proving keys.");
+    for (auto& [_, cd] : tx_rollup_cds) {
+        cd.proving_key.reset();
+    }
+    for (auto& [_, cd] : root_rollup_cds) {
+        cd.proving_key.reset();
+    }
+}
+
+// Postcondition: the returned circuit data has a proving key and verification key.
+tx_rollup::circuit_data& init_tx_rollup(size_t num_txs)
+{
+    auto& tx_rollup_cd = tx_rollup_cds[num_txs];
     if (tx_rollup_cd.proving_key) {
         // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
-        return;
+        return tx_rollup_cd;
     }
     if (lazy_init) {
-        // In lazy init mode we conserve memory. Throw away the root rollup proving key first.
-        info("Purging root rollup proving key.");
-        root_rollup_cd.proving_key.reset();
+        purge_rollup_proving_keys();
     }
     tx_rollup_cd = tx_rollup::get_circuit_data(
         num_txs, js_cd, account_cd, claim_cd, crs, data_path, true, persist, persist, true, true, mock_proofs);
+    return tx_rollup_cd;
 }
 
-bool create_tx_rollup()
+/**
+ * Postcondition: the returned circuit data has a verification key and padding proof, all a root rollup circuit needs
+ * of it. If they have been persisted, and `rebuild` isn't set, they are loaded from the circuit's manifest, without the
+ * proving key.
+ */
+tx_rollup::circuit_data& init_tx_rollup_verification_data(size_t num_txs)
+{
+    auto& tx_rollup_cd = tx_rollup_cds[num_txs];
+    if (tx_rollup_cd.verification_key && !tx_rollup_cd.padding_proof.empty()) {
+        return tx_rollup_cd;
+    }
+    if (persist && !rebuild) {
+        tx_rollup_cd = tx_rollup::get_circuit_data(
+            num_txs, js_cd, account_cd, claim_cd, crs, data_path, false, false, true, false, true, mock_proofs);
+        if (tx_rollup_cd.verification_key && !tx_rollup_cd.padding_proof.empty()) {
+            return tx_rollup_cd;
+        }
+    }
+    return init_tx_rollup(num_txs);
+}
+
+/**
+ * Adds the job that loads or computes a client circuit's (account, join split or claim) verification key and padding
+ * proof, all the tx rollups need of it: from its manifest if persisted and `rebuild` isn't set, which is quick. A
+ * proving key is only computed if the padding proof has to be, and is then released. The claim and account proving
+ * keys are loaded by the first proof made with them (see `init_client_proving_key`), and the join split's is never
+ * needed.
+ *
+ * `get_circuit_data(compute, load, pk)` gets the circuit's data, persisting it if on.
+ */
+template <typename F>
+startup_graph::job_id add_client_circuit_job(startup_graph& startup,
+                                             std::string const& name,
+                                             ::rollup::proofs::circuit_data& cd,
+                                             bool padding,
+                                             F const& get_circuit_data)
 {
-    init_tx_rollup(txs_per_inner);
+    return startup.add(name + " verification key", [&cd, padding, get_circuit_data] {
+        if (persist && !rebuild) {
+            cd = get_circuit_data(false, true, false);
+        }
+        if (!cd.verification_key || (padding && cd.padding_proof.empty())) {
+            cd = get_circuit_data(true, persist, padding);
+            cd.proving_key.reset();
+        }
+    });
+}
 
+/**
+ * Postcondition: the client circuit data has a proving key. Only the proving key is assigned, as the tx rollup circuit
+ * data holds the verification key it was built with.
+ */
+template <typename F> void init_client_proving_key(::rollup::proofs::circuit_data& cd, F const& get_circuit_data)
+{
+    if (!cd.proving_key) {
+        cd.proving_key = get_circuit_data(true, persist, true).proving_key;
+    }
+}
+
+account::circuit_data get_account_circuit_data(bool compute, bool load, bool pk)
+{
+    return account::get_circuit_data(crs, mock_proofs, data_path, compute, persist, load, pk);
+}
+
+join_split::circuit_data get_join_split_circuit_data(bool compute, bool load, bool pk)
+{
+    return join_split::get_circuit_data(crs, mock_proofs, data_path, compute, persist, load, pk);
+}
+
+claim::circuit_data get_claim_circuit_data(bool compute, bool load, bool pk)
+{
+    return claim::get_circuit_data(crs, mock_proofs, data_path, compute, persist, load, pk);
+}
+
+bool create_tx_rollup()
+{
     tx_rollup::rollup_tx rollup;
     std::cerr << "Reading tx rollup..." << std::endl;
     read(std::cin, rollup);
     std::cerr << "Received tx rollup with " << rollup.num_txs << " txs." << std::endl;
 
+    // The first inner rollup of a block uses the smallest circuit that fits, and the rest of the block's are padded to
+    // it, partly filled last one included. A caller can force a larger circuit by sending padding txs.
+    auto num_txs = block.inner_rollup_size(rollup.txs.size());
+    if (!num_txs) {
+        write(std::cout, std::vector<uint8_t>());
+        write(std::cout, false);
+        std::cout << std::flush;
+        return false;
+    }
+    auto& tx_rollup_cd = init_tx_rollup(num_txs);
+
+    // Reject invalid rollups before spending minutes building the circuit.
+    if (!tx_rollup::validate(rollup, tx_rollup_cd).valid) {
+        write(std::cout, std::vector<uint8_t>());
+        write(std::cout, false);
+        std::cout << std::flush;
+        return false;
+    }
+
     auto result = verify(rollup, tx_rollup_cd);
 
     write(std::cout, result.proof_data);
@@ -84,45 +217,132 @@ bool create_tx_rollup()
     return result.verified;
 }
 
-// Postcondition: root_rollup_cd has a proving key and verification key.
-void init_root_rollup(size_t num_rollups)
+// Postcondition: the returned circuit data has a proving key and verification key.
+root_rollup::circuit_data& init_root_rollup(size_t num_txs, size_t num_rollups)
 {
+    auto& root_rollup_cd = root_rollup_cds[{ num_txs, num_rollups }];
     if (root_rollup_cd.proving_key) {
         // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
-        return;
-    }
-    if (!tx_rollup_cd.verification_key) {
-        // If we've never created the tx rollup circuit data, we won't have a vk. Build it.
-        init_tx_rollup(txs_per_inner);
+        return root_rollup_cd;
     }
+    auto& tx_rollup_cd = init_tx_rollup_verification_data(num_txs);
     if (lazy_init) {
-        // In lazy init mode we conserve memory. Throw away the tx rollup proving key first.
-        info("Purging tx rollup proving key.");
-        tx_rollup_cd.proving_key.reset();
+        purge_rollup_proving_keys();
     }
     root_rollup_cd = root_rollup::get_circuit_data(
         num_rollups, tx_rollup_cd, crs, data_path, true, persist, persist, true, true, mock_proofs);
+    return root_rollup_cd;
 }
 
-bool create_root_rollup()
+/**
+ * Postcondition: the returned circuit data has a verification key and padding proof, all the root verifier circuit
+ * needs of it. If they have been persisted, and `rebuild` isn't set, they are loaded from the circuit's manifest,
+ * without the proving key.
+ */
+root_rollup::circuit_data& init_root_rollup_verification_data(size_t num_txs, size_t num_rollups)
 {
-    init_root_rollup(inners_per_root);
+    auto& root_rollup_cd = root_rollup_cds[{ num_txs, num_rollups }];
+    if (root_rollup_cd.verification_key && !root_rollup_cd.padding_proof.empty()) {
+        return root_rollup_cd;
+    }
+    if (persist && !rebuild) {
+        auto& tx_rollup_cd = init_tx_rollup_verification_data(num_txs);
+        root_rollup_cd = root_rollup::get_circuit_data(
+            num_rollups, tx_rollup_cd, crs, data_path, false, false, true, false, true, mock_proofs);
+        if (root_rollup_cd.verification_key && !root_rollup_cd.padding_proof.empty()) {
+            return root_rollup_cd;
+        }
+    }
+    return init_root_rollup(num_txs, num_rollups);
+}
+
+// Writes the broadcast data followed by the proof, as a single buffer.
+bool write_root_rollup_result(root_rollup::verify_result const& result)
+{
+    std::vector<uint8_t> buf;
+    buf.reserve(result.broadcast_data.size() * 32 + result.proof_data.size());
+    root_rollup::write_broadcast_fields(buf, result.broadcast_data);
+    buf.insert(buf.end(), result.proof_data.begin(), result.proof_data.end());
+
+    write(std::cout, buf);
+    write(std::cout, result.verified);
+    std::cout << std::flush;
 
+    return result.verified;
+}
+
+bool create_root_rollup()
+{
     root_rollup::root_rollup_tx root_rollup;
     std::cerr << "Reading root rollup..." << std::endl;
     read(std::cin, root_rollup);
     std::cerr << "Received root rollup with " << root_rollup.rollups.size() << " rollups." << std::endl;
 
-    auto result = verify(root_rollup, root_rollup_cd);
+    auto [num_txs, num_rollups] = block.root_rollup_size(root_rollup.rollups, root_rollup.num_inner_proofs);
+    block.finish_block();
+    if (!num_rollups) {
+        return write_root_rollup_result({});
+    }
+    std::cerr << "Using root rollup circuit " << num_txs << "x" << num_rollups << "." << std::endl;
+
+    auto result = verify(root_rollup, init_root_rollup(num_txs, num_rollups));
+    return write_root_rollup_result(result);
+}
 
-    root_rollup::root_rollup_broadcast_data broadcast_data(result.broadcast_data);
-    auto buf = join({ to_buffer(broadcast_data), result.proof_data });
+bool start_root_rollup_session()
+{
+    root_rollup::root_rollup_tx root_rollup;
+    std::cerr << "Reading root rollup session header..." << std::endl;
+    read(std::cin, root_rollup);
+    std::cerr << "Starting root rollup session for " << root_rollup.num_inner_proofs << " rollups, "
+              << root_rollup.rollups.size() << " received." << std::endl;
+
+    root_rollup_session.reset();
+    // The circuit is sized from the inner proofs, and is built as they arrive, so it can't be guessed up front.
+    if (root_rollup.rollups.empty()) {
+        std::cerr << "Root rollup session header has no inner proofs to size the circuit from." << std::endl;
+        write(std::cout, false);
+        std::cout << std::flush;
+        return false;
+    }
+    auto [num_txs, num_rollups] = block.root_rollup_size(root_rollup.rollups, root_rollup.num_inner_proofs);
+    if (num_rollups) {
+        root_rollup_session = std::make_unique<root_rollup::root_rollup_session>(
+            root_rollup, init_root_rollup(num_txs, num_rollups));
+    }
+    bool started = root_rollup_session && !root_rollup_session->failed();
 
-    write(std::cout, buf);
-    write(std::cout, result.verified);
+    write(std::cout, started);
     std::cout << std::flush;
 
-    return result.verified;
+    return started;
+}
+
+bool add_to_root_rollup_session()
+{
+    std::vector<uint8_t> proof;
+    std::cerr << "Reading inner rollup proof..." << std::endl;
+    read(std::cin, proof);
+
+    bool added = root_rollup_session && root_rollup_session->add(proof);
+
+    write(std::cout, added);
+    std::cout << std::flush;
+
+    return added;
+}
+
+bool finish_root_rollup_session()
+{
+    root_rollup::verify_result result;
+    if (root_rollup_session) {
+        result = root_rollup_session->finish();
+        root_rollup_session.reset();
+        block.finish_block();
+    } else {
+        std::cerr << "No root rollup session in progress." << std::endl;
+    }
+    return write_root_rollup_result(result);
 }
 
 bool create_claim()
@@ -131,6 +351,7 @@ bool create_claim()
     std::cerr << "Reading claim tx..." << std::endl;
     read(std::cin, claim_tx);
 
+    init_client_proving_key(claim_cd, &get_claim_circuit_data);
     auto result = verify(claim_tx, claim_cd);
 
     write(std::cout, result.proof_data);
@@ -147,13 +368,15 @@ void init_root_verifier()
         // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
         return;
     }
-    if (!root_rollup_cd.verification_key) {
-        // If we've never created the root rollup circuit data, we won't have a vk. Build it.
-        init_root_rollup(txs_per_inner);
+    // The root verifier accepts a proof from any of the root rollup circuits, so needs all of their vks.
+    std::vector<std::shared_ptr<waffle::verification_key>> valid_vks;
+    for (auto [num_txs, num_rollups] : root_verifier::get_valid_root_rollup_sizes(txs_per_inner, inners_per_root)) {
+        valid_vks.push_back(init_root_rollup_verification_data(num_txs, num_rollups).verification_key);
     }
-    root_verifier_cd = root_verifier::get_circuit_data(root_rollup_cd,
+    auto const& largest_root_rollup_cd = root_rollup_cds[{ txs_per_inner.back(), inners_per_root.back() }];
+    root_verifier_cd = root_verifier::get_circuit_data(largest_root_rollup_cd,
                                                        crs,
-                                                       { root_rollup_cd.verification_key },
+                                                       valid_vks,
                                                        data_path,
                                                        true,
                                                        persist,
@@ -163,6 +386,30 @@ void init_root_verifier()
                                                        mock_proofs);
 }
 
+/**
+ * Finds the root rollup circuit a root rollup proof was created with. Circuits of the same total size can't be told
+ * apart from the broadcast data, so the proof is natively verified against each candidate's vk.
+ */
+root_rollup::circuit_data const& find_root_rollup_circuit_data(root_verifier::root_verifier_tx const& tx)
+{
+    auto rollup_size = root_rollup::root_rollup_broadcast_view(tx.broadcast_data).rollup_size_u32();
+    root_rollup::circuit_data const* found = nullptr;
+    for (auto const& [_, cd] : root_rollup_cds) {
+        if (cd.rollup_size != rollup_size || !cd.verification_key) {
+            continue;
+        }
+        found = found ? found : &cd;
+        auto const& vk = cd.verification_key;
+        auto manifest = circuit_types::Composer::create_unrolled_manifest(vk->num_public_inputs);
+        circuit_types::UnrolledVerifier verifier(vk, manifest);
+        if (verifier.verify_proof(waffle::plonk_proof{ tx.proof_data })) {
+            return cd;
+        }
+    }
+    // Nothing verified. Let the circuit report the failure.
+    return found ? *found : root_rollup_cds.rbegin()->second;
+}
+
 bool create_root_verifier()
 {
     init_root_verifier();
@@ -171,10 +418,60 @@ bool create_root_verifier()
     std::cerr << "Reading root verifier tx..." << std::endl;
     read(std::cin, root_rollup_proof_buf);
 
-    auto rollup_size = inners_per_root * tx_rollup_cd.rollup_size;
-    auto tx = root_verifier::create_root_verifier_tx(root_rollup_proof_buf, rollup_size);
+    auto tx = root_verifier::create_root_verifier_tx(root_rollup_proof_buf);
 
-    auto result = verify(tx, root_verifier_cd, root_rollup_cd);
+    auto result = verify(tx, root_verifier_cd, find_root_rollup_circuit_data(tx));
+
+    result.proof_data = join({ tx.broadcast_data, result.proof_data });
+    write(std::cout, result.proof_data);
+    write(std::cout, (uint8_t)result.verified);
+    std::cout << std::flush;
+
+    return result.verified;
+}
+
+/**
+ * Creates a root rollup proof and the root verifier proof over it in one job, returning both as commands 1 and 3 would.
+ * The root rollup proof is handed over in memory, and the proof independent part of the root verifier circuit is
+ * built while the root rollup is proving.
+ */
+bool create_root_rollup_and_verifier()
+{
+    root_rollup::root_rollup_tx root_rollup;
+    std::cerr << "Reading root rollup..." << std::endl;
+    read(std::cin, root_rollup);
+    std::cerr << "Received root rollup with " << root_rollup.rollups.size() << " rollups." << std::endl;
+
+    auto [num_txs, num_rollups] = block.root_rollup_size(root_rollup.rollups, root_rollup.num_inner_proofs);
+    block.finish_block();
+    if (!num_rollups) {
+        write_root_rollup_result({});
+        write(std::cout, std::vector<uint8_t>());
+        write(std::cout, (uint8_t)false);
+        std::cout << std::flush;
+        return false;
+    }
+
+    // The root verifier may need to build other root rollup circuits for their vks, so init it first.
+    init_root_verifier();
+    auto& root_rollup_cd = init_root_rollup(num_txs, num_rollups);
+
+    auto prepared = std::async(std::launch::async, [&] {
+        return root_verifier::prepare_circuit(root_verifier_cd, root_rollup_cd);
+    });
+    auto root_rollup_result = verify(root_rollup, root_rollup_cd);
+    auto prepared_circuit = prepared.get();
+
+    write_root_rollup_result(root_rollup_result);
+    if (!root_rollup_result.verified) {
+        write(std::cout, std::vector<uint8_t>());
+        write(std::cout, (uint8_t)false);
+        std::cout << std::flush;
+        return false;
+    }
+
+    auto tx = root_verifier::create_root_verifier_tx(root_rollup_result);
+    auto result = verify(*prepared_circuit, tx, root_verifier_cd, root_rollup_cd);
 
     result.proof_data = join({ tx.broadcast_data, result.proof_data });
     write(std::cout, result.proof_data);
@@ -190,6 +487,7 @@ bool create_account_proof()
     std::cerr << "Reading account tx..." << std::endl;
     read(std::cin, account_tx);
 
+    init_client_proving_key(account_cd, &get_account_circuit_data);
     auto result = verify(account_tx, account_cd);
 
     write(std::cout, result.proof_data);
@@ -207,30 +505,46 @@ int main(int argc, char** argv)
     info("Command line: ", join(args, " "));
 
     const std::string srs_path = (args.size() > 1) ? args[1] : "../barretenberg/cpp/srs_db/ignition";
-    txs_per_inner = args.size() > 2 ? (std::stoul(args[2])) : 1;
-    inners_per_root = args.size() > 3 ? (std::stoul(args[3])) : 1;
+    txs_per_inner = parse_sizes(args.size() > 2 ? args[2] : "1");
+    inners_per_root = parse_sizes(args.size() > 3 ? args[3] : "1");
     mock_proofs = args.size() > 4 ? args[4] == "true" : false;
     lazy_init = args.size() > 5 ? args[5] == "true" : false;
     persist = args.size() > 6 ? args[6] == "true" : true;
     data_path = (args.size() > 7) ? args[7] : "./data";
+    max_startup_jobs = (args.size() > 8) ? std::stoul(args[8]) : 2;
+    rebuild = args.size() > 9 ? args[9] == "true" : false;
+    block = root_rollup::block_sizes(txs_per_inner, inners_per_root);
 
-    info("Txs per inner: ", txs_per_inner);
-    info("Inners per root: ", inners_per_root);
+    info("Txs per inner: ", join(map(txs_per_inner, [](size_t n) { return std::to_string(n); }), ","));
+    info("Inners per root: ", join(map(inners_per_root, [](size_t n) { return std::to_string(n); }), ","));
     info("Mock proofs: ", mock_proofs);
     info("Lazy init: ", lazy_init);
     info("Persist: ", persist);
     info("Data path: ", data_path);
+    info("Max startup jobs: ", max_startup_jobs);
+    info("Rebuild: ", rebuild);
 
     if (mock_proofs) {
         info("Running in mock proof mode. Mock proofs will be generated!");
     }
 
     info("Loading crs...");
-    crs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(srs_path);
-
-    account_cd = account::get_circuit_data(crs, mock_proofs);
-    js_cd = join_split::get_circuit_data(crs, mock_proofs);
-    claim_cd = claim::get_circuit_data(crs, mock_proofs);
+    // Every process started over the same SRS maps the same point table, sharing its pages. The startup jobs below ask
+    // for prover reference strings from several threads at once, which the mapped factory serializes itself.
+    crs = std::make_shared<mapped_reference_string_factory>(srs_path, data_path);
+
+    // Circuit data is loaded or computed in parallel where it doesn't depend on other circuit data. Every entry is
+    // added to the circuit data maps up front, so the jobs only ever look entries up.
+    for (auto num_txs : txs_per_inner) {
+        tx_rollup_cds[num_txs];
+        for (auto num_rollups : inners_per_root) {
+            root_rollup_cds[{ num_txs, num_rollups }];
+        }
+    }
+    startup_graph startup;
+    auto account_job = add_client_circuit_job(startup, "account", account_cd, false, &get_account_circuit_data);
+    auto js_job = add_client_circuit_job(startup, "join split", js_cd, true, &get_join_split_circuit_data);
+    auto claim_job = add_client_circuit_job(startup, "claim", claim_cd, false, &get_claim_circuit_data);
 
     // Lazy init mode conserves memory by purging and recomputing tx/root proving keys.
     // If the halloumi instance is targeted to produce a specific type of proof, use lazy init as it will only
@@ -240,12 +554,21 @@ int main(int argc, char** argv)
     // too big. It can be useful for determining to total memory footprint of the process for certain circuit sizes.
     if (!lazy_init) {
         info("Running in eager init mode, all proving keys will be created once up front.");
-        init_tx_rollup(txs_per_inner);
-        init_root_rollup(inners_per_root);
-        init_root_verifier();
+        std::vector<startup_graph::job_id> root_rollup_jobs;
+        for (auto num_txs : txs_per_inner) {
+            auto tx_rollup_job = startup.add_heavy(
+                format("tx rollup ", num_txs), [=] { init_tx_rollup(num_txs); }, { account_job, js_job, claim_job });
+            for (auto num_rollups : inners_per_root) {
+                root_rollup_jobs.push_back(startup.add_heavy(format("root rollup ", num_txs, "x", num_rollups),
+                                                             [=] { init_root_rollup(num_txs, num_rollups); },
+                                                             { tx_rollup_job }));
+            }
+        }
+        startup.add_heavy("root verifier", [] { init_root_verifier(); }, root_rollup_jobs);
     } else {
         info("Running in lazy init mode, tx rollup and root rollup proving keys will be swapped in and out.");
     }
+    startup.run(max_startup_jobs);
 
     info("Reading rollups from standard input...");
     while (true) {
@@ -278,6 +601,22 @@ int main(int argc, char** argv)
             create_account_proof();
             break;
         }
+        case 5: {
+            start_root_rollup_session();
+            break;
+        }
+        case 6: {
+            add_to_root_rollup_session();
+            break;
+        }
+        case 7: {
+            finish_root_rollup_session();
+            break;
+        }
+        case 8: {
+            create_root_rollup_and_verifier();
+            break;
+        }
         case 100: {
             // Convert to buffer first, so when we call write we prefix the buffer length.
             std::cerr << "Serving join split vk..." << std::endl;
@@ -0,0 +1,129 @@
+#pragma once
+#include <common/log.hpp>
+#include <common/throw_or_abort.hpp>
+#include <common/timer.hpp>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * The jobs that load or compute circuit data at startup, and what each needs done first.
+ *
+ * `run` starts every job as soon as its dependencies are done, so startup takes as long as the longest chain of
+ * dependent jobs rather than all of them. Heavy jobs (building and computing keys of large circuits) take up memory
+ * and every core, so at most `max_heavy_jobs` run at once. Light jobs always run.
+ *
+ * A job can only depend on jobs added before it, so the graph is acyclic by construction.
+ */
+class startup_graph {
+  public:
+    using job_id = size_t;
+
+    job_id add(std::string const& name, std::function<void()> const& fn, std::vector<job_id> const& dependencies = {})
+    {
+        return add_job(name, fn, dependencies, false);
+    }
+
+    job_id add_heavy(std::string const& name,
+                     std::function<void()> const& fn,
+                     std::vector<job_id> const& dependencies = {})
+    {
+        return add_job(name, fn, dependencies, true);
+    }
+
+    // Runs every job and waits for them all. Rethrows the first exception a job throws, once all have finished.
+    void run(size_t max_heavy_jobs)
+    {
+        max_heavy_jobs_ = std::max(max_heavy_jobs, size_t(1));
+        Timer timer;
+        std::vector<std::shared_future<void>> done;
+        done.reserve(jobs_.size());
+        for (auto const& job : jobs_) {
+            std::vector<std::shared_future<void>> dependencies;
+            for (auto id : job.dependencies) {
+                dependencies.push_back(done[id]);
+            }
+            done.push_back(std::async(std::launch::async, [this, &job, dependencies] {
+                               for (auto const& dependency : dependencies) {
+                                   dependency.get();
+                               }
+                               run_job(job);
+                           }).share());
+        }
+
+        std::exception_ptr error;
+        for (auto const& job : done) {
+            try {
+                job.get();
+            } catch (...) {
+                error = error ? error : std::current_exception();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        info("Startup completed in ", timer.toString(), "s");
+    }
+
+  private:
+    struct job {
+        std::string name;
+        std::function<void()> fn;
+        std::vector<job_id> dependencies;
+        bool heavy;
+    };
+
+    job_id add_job(std::string const& name,
+                   std::function<void()> const& fn,
+                   std::vector<job_id> const& dependencies,
+                   bool heavy)
+    {
+        for (auto id : dependencies) {
+            if (id >= jobs_.size()) {
+                throw_or_abort(format("Startup job ", name, " depends on a job that hasn't been added."));
+            }
+        }
+        jobs_.push_back({ name, fn, dependencies, heavy });
+        return jobs_.size() - 1;
+    }
+
+    void run_job(job const& job)
+    {
+        if (job.heavy) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            heavy_slot_free_.wait(lock, [&] { return num_heavy_running_ < max_heavy_jobs_; });
+            num_heavy_running_++;
+        }
+        Timer timer;
+        info("Starting ", job.name, "...");
+        try {
+            job.fn();
+        } catch (...) {
+            release(job);
+            throw;
+        }
+        release(job);
+        info("Finished ", job.name, " in ", timer.toString(), "s");
+    }
+
+    void release(job const& job)
+    {
+        if (!job.heavy) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            num_heavy_running_--;
+        }
+        heavy_slot_free_.notify_one();
+    }
+
+    std::vector<job> jobs_;
+    size_t max_heavy_jobs_ = 1;
+    size_t num_heavy_running_ = 0;
+    std::mutex mutex_;
+    std::condition_variable heavy_slot_free_;
+};
@@ -1,3 +1,5 @@
+#include "../proofs/account/index.hpp"
+#include "../proofs/claim/index.hpp"
 #include "../proofs/join_split/index.hpp"
 #include "../proofs/rollup/index.hpp"
 #include "../proofs/root_rollup/index.hpp"
@@ -5,30 +7,30 @@
 #include "../world_state/world_state.hpp"
 #include "../constants.hpp"
 #include "../fixtures/compute_or_load_fixture.hpp"
+#include "../fixtures/tx_mix_generator.hpp"
+#include "../proofs/circuit_types.hpp"
+#include "../proofs/mapped_reference_string_factory.hpp"
+#include "noop_proof_factory.hpp"
 #include <common/streams.hpp>
 #include <iostream>
 #include <stdlib/merkle_tree/index.hpp>
 
 using namespace ::rollup::proofs;
-using namespace ::rollup::fixtures;
 using namespace plonk::stdlib::merkle_tree;
-using namespace plonk::stdlib::types::turbo;
+using namespace ::rollup::proofs::circuit_types;
 namespace tx_rollup = ::rollup::proofs::rollup;
 using WorldState = ::rollup::world_state::WorldState<MemoryStore>;
 
 tx_rollup::rollup_tx create_inner_rollup(uint32_t num_txs,
                                          uint32_t rollup_size,
-                                         join_split::circuit_data const& join_split_circuit_data,
-                                         barretenberg::fr const& data_tree_root,
-                                         WorldState& world_state,
-                                         bool mock_proofs)
+                                         ::rollup::tx_factory::noop_proof_factory& proof_factory,
+                                         size_t first_proof,
+                                         WorldState& world_state)
 {
     info("Generating a ", rollup_size, " rollup with ", num_txs, " txs...");
-    auto proofs = std::vector<std::vector<uint8_t>>(num_txs);
-    for (size_t i = 0; i < num_txs; ++i) {
-        proofs[i] =
-            join_split::create_noop_join_split_proof(join_split_circuit_data, data_tree_root, true, mock_proofs);
-    }
+    Timer timer;
+    auto proofs = proof_factory.create(first_proof, num_txs);
+    info("Generated ", num_txs, " txs in ", timer.toString(), "s");
     return tx_rollup::create_rollup_tx(world_state, rollup_size, proofs);
 }
 
@@ -42,7 +44,10 @@ int main(int argc, char** argv)
     if (args.size() < 4) {
         info("usage:\n",
              args[0],
-             " <num_txs> <inner_rollup_size> <outer_rollup_size> <split_proofs_across_rollups> [output_file]");
+             " <num_txs> <inner_rollup_size> <outer_rollup_size> <split_proofs_across_rollups> [mock_proofs] "
+             "[output_file] [data_path] [num_proving_threads] [proof_corpus_path] [noop|mixed]\n",
+             "mixed proves twice num_txs client txs, one at a time rather than on num_proving_threads workers, and "
+             "without the proof corpus, so with real proofs it is far slower than noop.");
         return -1;
     }
 
@@ -52,22 +57,60 @@ int main(int argc, char** argv)
     const bool split_txns_across_rollups = args.size() > 4 ? args[4] == "true" : true;
     const bool mock_proofs = args.size() > 5 ? args[5] == "true" : true;
     const std::string output_file = args[6];
-
-    auto crs = std::make_shared<waffle::DynamicFileReferenceStringFactory>("../barretenberg/cpp/srs_db/ignition");
-    auto join_split_circuit_data = join_split::get_circuit_data(crs, mock_proofs);
+    // Where the join split circuit's keys are persisted, as rollup_cli does.
+    const std::string data_path = args.size() > 7 ? args[7] : "./data";
+    // Client proofs are created on this many threads, each with its own copy of the join split proving key.
+    const size_t num_proving_threads = args.size() > 8 ? std::stoul(args[8]) : 4;
+    // If given, client proofs are cached here, and reused by later runs.
+    const std::string proof_corpus_path = args.size() > 9 ? args[9] : "";
+    // Either noop deposits, or a realistic mix of txs (see tx_mix_generator), proven one at a time and not cached, as
+    // each is built over the world state the txs before it left. num_proving_threads only applies to noop deposits.
+    const bool mixed_txs = args.size() > 10 && args[10] == "mixed";
+
+    const std::string srs_path = "../barretenberg/cpp/srs_db/ignition";
+    auto crs = std::make_shared<mapped_reference_string_factory>(srs_path, data_path);
+    auto join_split_circuit_data = join_split::get_circuit_data(crs, mock_proofs, data_path, true, true, true);
     auto data_root = world_state.data_tree.root();
     world_state.root_tree.update_element(0, data_root);
+    ::rollup::tx_factory::noop_proof_factory proof_factory(
+        join_split_circuit_data, data_root, mock_proofs, num_proving_threads, proof_corpus_path);
 
     Timer timer;
 
-    std::vector<std::vector<uint8_t>> rollups_data;
+    std::vector<size_t> rollup_num_txs;
     const auto num_total_txs = num_txs;
     while (num_txs > 0) {
         auto n = split_txns_across_rollups ? (num_total_txs / outer_rollup_size) : std::min(num_txs, inner_rollup_size);
+        rollup_num_txs.push_back(n);
         num_txs -= n;
+    }
+
+    account::circuit_data account_circuit_data;
+    claim::circuit_data claim_circuit_data;
+    std::unique_ptr<::rollup::fixtures::TestContext> context;
+    std::unique_ptr<::rollup::fixtures::tx_mix_generator> tx_mix;
+    std::vector<tx_rollup::rollup_tx> mixed_rollups;
+    if (mixed_txs) {
+        account_circuit_data = account::get_circuit_data(crs, mock_proofs, data_path, true, true, true);
+        claim_circuit_data = claim::get_circuit_data(crs, mock_proofs, data_path, true, true, true);
+        context = std::make_unique<::rollup::fixtures::TestContext>(
+            join_split_circuit_data, account_circuit_data, claim_circuit_data);
+        tx_mix = std::make_unique<::rollup::fixtures::tx_mix_generator>(*context, ::rollup::fixtures::tx_mix());
+        // A block that isn't proven goes first, so the proven one claims its defi deposits and spends its notes.
+        info("Generating txs of a preceding block...");
+        tx_mix->create_rollup_txs(inner_rollup_size, rollup_num_txs);
+        tx_mix->create_root_rollup_tx({});
+        info("Generating txs...");
+        mixed_rollups = tx_mix->create_rollup_txs(inner_rollup_size, rollup_num_txs);
+    }
 
-        auto rollup =
-            create_inner_rollup(n, inner_rollup_size, join_split_circuit_data, data_root, world_state, mock_proofs);
+    std::vector<std::vector<uint8_t>> rollups_data;
+    size_t first_proof = 0;
+    for (size_t i = 0; i < rollup_num_txs.size(); ++i) {
+        auto n = static_cast<uint32_t>(rollup_num_txs[i]);
+        auto rollup = mixed_txs ? mixed_rollups[i]
+                                : create_inner_rollup(n, inner_rollup_size, proof_factory, first_proof, world_state);
+        first_proof += n;
 
         info("Sending tx rollup request with ", n, " txs...");
         write(std::cout, (uint32_t)0);
@@ -85,8 +128,12 @@ int main(int argc, char** argv)
         rollups_data.push_back(proof_data);
     }
 
-    auto root_rollup = root_rollup::create_root_rollup_tx(
-        world_state, 0, world_state.defi_tree.root(), world_state.defi_tree.get_hash_path(0), rollups_data);
+    auto root_rollup = mixed_txs ? tx_mix->create_root_rollup_tx(rollups_data)
+                                 : root_rollup::create_root_rollup_tx(world_state,
+                                                                      0,
+                                                                      world_state.defi_tree.root(),
+                                                                      world_state.defi_tree.get_hash_path(0),
+                                                                      rollups_data);
 
     info("Sending root rollup request...");
     write(std::cout, (uint32_t)1);
@@ -0,0 +1,108 @@
+#pragma once
+#include "../proofs/join_split/index.hpp"
+#include "../proofs/circuit_key_cache.hpp"
+#include "../proofs/proving_key_stream.hpp"
+#include "../proofs/prover_context.hpp"
+#include "../fixtures/compute_or_load_fixture.hpp"
+#include <atomic>
+#include <future>
+#include <thread>
+#ifndef NO_MULTITHREADING
+#include <omp.h>
+#endif
+
+namespace rollup {
+namespace tx_factory {
+
+using namespace ::rollup::proofs;
+
+/**
+ * Creates valid noop join split proofs over a data root, on a pool of worker threads.
+ *
+ * Each worker proves through its own prover context, with its own copy of the proving key, as a prover writes its
+ * working polynomials into the key it proves with. A copy is only made once its worker has a proof to compute. The
+ * cores are split evenly between the workers, rather than every prover's threads competing for all of them.
+ *
+ * Given a corpus path, the n'th proof is cached there, and later runs over the same circuit and data root load it
+ * rather than computing it again. Noop proofs spend random nullifiers, so the proofs of one run never conflict.
+ */
+class noop_proof_factory {
+  public:
+    noop_proof_factory(join_split::circuit_data const& cd,
+                       barretenberg::fr const& data_root,
+                       bool mock,
+                       size_t num_workers,
+                       std::string const& corpus_path)
+        : cd_(cd)
+        , data_root_(data_root)
+        , mock_(mock)
+        , contexts_(std::max(num_workers, size_t(1)))
+    {
+        if (!corpus_path.empty()) {
+            auto name = format("noop_join_split_", data_root);
+            auto composer_name = GET_COMPOSER_NAME_STRING(circuit_types::Composer);
+            corpus_path_ = corpus_path + "/" + circuit_key_hash(name, composer_name, mock, { cd.verification_key });
+            info("Proof corpus: ", corpus_path_);
+        }
+    }
+
+    // Proofs `first` to `first + num_proofs` (exclusive) of this run.
+    std::vector<std::vector<uint8_t>> create(size_t first, size_t num_proofs)
+    {
+        std::vector<std::vector<uint8_t>> proofs(num_proofs);
+        std::atomic<size_t> next = 0;
+        std::vector<std::future<void>> workers;
+        for (size_t w = 0; w < std::min(contexts_.size(), num_proofs); ++w) {
+            workers.push_back(std::async(std::launch::async, [&, w] {
+#ifndef NO_MULTITHREADING
+                omp_set_num_threads(
+                    (int)std::max(std::thread::hardware_concurrency() / contexts_.size(), size_t(1)));
+#endif
+                auto compute = [this, w] { return create_proof(w); };
+                for (size_t i = next++; i < num_proofs; i = next++) {
+                    proofs[i] = corpus_path_.empty() ? compute()
+                                                     : fixtures::compute_or_load_fixture(
+                                                           corpus_path_, format("proof_", first + i), compute);
+                }
+            }));
+        }
+        for (auto& worker : workers) {
+            worker.get();
+        }
+        return proofs;
+    }
+
+  private:
+    std::vector<uint8_t> create_proof(size_t worker)
+    {
+        auto& context = contexts_[worker];
+        if (!context) {
+            context = std::make_unique<prover_context<join_split::join_split_tx>>(
+                copy_proving_key(), join_split::join_split_circuit, mock_);
+        }
+        auto tx = join_split::noop_tx();
+        tx.num_input_notes = 0;
+        tx.old_data_root = data_root_;
+        return context->prove(tx);
+    }
+
+    std::shared_ptr<waffle::proving_key> copy_proving_key()
+    {
+        std::vector<uint8_t> buf(serialized_proving_key_size(*cd_.proving_key));
+        auto it = buf.data();
+        write(it, *cd_.proving_key);
+        waffle::proving_key_data pk_data;
+        uint8_t const* read_it = buf.data();
+        read(read_it, pk_data);
+        return std::make_shared<waffle::proving_key>(std::move(pk_data), cd_.proving_key->reference_string);
+    }
+
+    join_split::circuit_data const& cd_;
+    barretenberg::fr data_root_;
+    bool mock_;
+    std::string corpus_path_;
+    std::vector<std::unique_ptr<prover_context<join_split::join_split_tx>>> contexts_;
+};
+
+} // namespace tx_factory
+} // namespace rollup
@@ -0,0 +1,111 @@
+#pragma once
+#include <stdlib/merkle_tree/merkle_tree.hpp>
+#include <crypto/pedersen/pedersen.hpp>
+#include "../proofs/rollup/indexed_nullifier_insertion.hpp"
+#include "../proofs/notes/constants.hpp"
+#include "../constants.hpp"
+#include <common/log.hpp>
+#include <common/throw_or_abort.hpp>
+#include <map>
+
+namespace rollup {
+namespace world_state {
+
+using namespace plonk::stdlib::merkle_tree;
+using proofs::rollup::indexed_nullifier_insertion;
+
+/**
+ * An indexed (low-nullifier) tree. Nullifiers are appended to a shallow tree, and each leaf commits to its value and
+ * the index and value of the next largest nullifier, forming a sorted linked list. Non-membership of a nullifier is
+ * shown by the leaf that would precede it in the list, so inserting needs two `INDEXED_NULL_TREE_DEPTH` paths,
+ * rather than one `NULL_TREE_DEPTH` path indexed by the nullifier itself.
+ * Leaf 0 is a sentinel (0, 0, 0), the head of the list. A next value of 0 marks the end of the list.
+ *
+ * The leaves' preimages are only held in memory, so the tree can't be reopened from a store that already holds it.
+ */
+template <typename Store> class IndexedTree {
+    struct leaf {
+        fr value;
+        uint32_t next_index;
+        fr next_value;
+    };
+
+  public:
+    IndexedTree(Store& store, size_t depth, uint8_t tree_id)
+        : tree_(store, depth, tree_id)
+    {
+        if (tree_.size() != 0) {
+            throw_or_abort(
+                format("Indexed tree ", int(tree_id), " can't be rebuilt from the leaf hashes in its store."));
+        }
+        append({ 0, 0, 0 });
+    }
+
+    static fr hash_leaf(fr const& value, uint32_t next_index, fr const& next_value)
+    {
+        return crypto::pedersen::compress_native({ value, fr(next_index), next_value },
+                                                 proofs::notes::GeneratorIndex::INDEXED_NULLIFIER_LEAF);
+    }
+
+    /**
+     * Inserts `nullifier`, returning the witness the rollup circuit needs to check the insertion.
+     * A zero nullifier is a noop, whose low leaf is the sentinel as it currently stands. A nullifier already in the
+     * tree is not inserted, and gets a witness the circuit will reject.
+     */
+    indexed_nullifier_insertion insert(fr const& nullifier)
+    {
+        auto root = tree_.root();
+        auto new_index = static_cast<uint32_t>(leaves_.size());
+
+        if (nullifier == 0) {
+            auto const& head = leaves_[0];
+            return { head.value, head.next_index, head.next_value, 0, tree_.get_hash_path(0),
+                     new_index,  tree_.get_hash_path(new_index),    root, root };
+        }
+
+        auto it = std::prev(sorted_.lower_bound(uint256_t(nullifier)));
+        auto low_index = it->second;
+        auto low = leaves_[low_index];
+        indexed_nullifier_insertion insertion{ low.value,
+                                               low.next_index,
+                                               low.next_value,
+                                               low_index,
+                                               tree_.get_hash_path(low_index),
+                                               new_index,
+                                               {},
+                                               root,
+                                               root };
+
+        if (low.next_value == nullifier) {
+            insertion.new_leaf_path = tree_.get_hash_path(new_index);
+            return insertion;
+        }
+
+        leaves_[low_index] = { low.value, new_index, nullifier };
+        insertion.low_updated_root = tree_.update_element(low_index, hash_leaf(low.value, new_index, nullifier));
+        insertion.new_leaf_path = tree_.get_hash_path(new_index);
+        insertion.new_root = append({ nullifier, low.next_index, low.next_value });
+        return insertion;
+    }
+
+    fr root() { return tree_.root(); }
+
+    size_t size() const { return leaves_.size(); }
+
+  private:
+    fr append(leaf const& l)
+    {
+        auto index = static_cast<uint32_t>(leaves_.size());
+        leaves_.push_back(l);
+        sorted_[uint256_t(l.value)] = index;
+        return tree_.update_element(index, hash_leaf(l.value, l.next_index, l.next_value));
+    }
+
+    MerkleTree<Store> tree_;
+    std::vector<leaf> leaves_;
+    // Leaf index of each value, for finding low leaves.
+    std::map<uint256_t, uint32_t> sorted_;
+};
+
+} // namespace world_state
+} // namespace rollup
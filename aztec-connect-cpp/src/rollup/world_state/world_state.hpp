@@ -1,10 +1,12 @@
 #pragma once
 #include <stdlib/merkle_tree/merkle_tree.hpp>
+#include "indexed_tree.hpp"
 #include "../proofs/notes/native/defi_interaction/note.hpp"
 #include "../proofs/notes/native/value/value_note.hpp"
 #include "../proofs/notes/native/account/account_note.hpp"
 #include "../proofs/notes/native/claim/claim_note.hpp"
 #include "../constants.hpp"
+#include <memory>
 
 namespace rollup {
 namespace world_state {
@@ -55,14 +57,41 @@ template <typename Store> class WorldState {
         }
     }
 
-    void nullify(uint256_t index) { null_tree.update_element(index, { 1 }); }
+    void nullify(uint256_t index)
+    {
+        null_tree.update_element(index, { 1 });
+        if (indexed_null_tree) {
+            indexed_null_tree->insert(fr(index));
+        }
+        has_nullified_ = true;
+    }
+
+    /**
+     * Starts tracking nullifiers in `indexed_null_tree`, for rollup circuits built with `NullifierTree::INDEXED`.
+     * The indexed tree can't be rebuilt from `null_tree`, so this must be called before anything is nullified.
+     */
+    void enable_indexed_null_tree()
+    {
+        if (indexed_null_tree) {
+            return;
+        }
+        if (has_nullified_) {
+            throw_or_abort("Indexed nullifier tree must be enabled before anything is nullified.");
+        }
+        indexed_null_tree = std::make_unique<IndexedTree<Store>>(store, INDEXED_NULL_TREE_DEPTH, 4);
+    }
 
     Store store;
     Tree data_tree;
     Tree null_tree;
     Tree root_tree;
     Tree defi_tree;
+    // Tracks the same nullifiers as `null_tree` once enabled, and is null until then.
+    std::unique_ptr<IndexedTree<Store>> indexed_null_tree;
     std::vector<barretenberg::fr> input_nullifiers;
+
+  private:
+    bool has_nullified_ = false;
 };
 
 } // namespace world_state
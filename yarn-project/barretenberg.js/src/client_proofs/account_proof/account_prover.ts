@@ -1,6 +1,5 @@
 import { SchnorrSignature } from '../../crypto/index.js';
 import { executeTimeout } from '../../timer/index.js';
-import { Transfer } from '../../transport/index.js';
 import { UnrolledProver } from '../prover/index.js';
 import { AccountTx } from './account_tx.js';
 import { createAccountProofSigningData } from './create_account_proof_signing_data.js';
@@ -28,10 +27,17 @@ export class AccountProver {
 
   public async loadKey(keyBuf: Buffer) {
     const worker = this.prover.getWorker();
-    const keyPtr = await worker.call('bbmalloc', keyBuf.length);
-    await worker.transferToHeap(Transfer(keyBuf, [keyBuf.buffer]) as any, keyPtr);
-    await worker.call('account__init_proving_key_from_buffer', keyPtr);
-    await worker.call('bbfree', keyPtr);
+    // Hand the key over a chunk at a time. Chunks are freed as the key is read, so the heap never holds two keys.
+    const chunkSize = 16 * 1024 * 1024;
+    const chunkPtr = await worker.call('bbmalloc', Math.min(chunkSize, keyBuf.length));
+    const reader = await worker.call('account__new_proving_key_reader');
+    for (let i = 0; i < keyBuf.length; i += chunkSize) {
+      const chunk = keyBuf.subarray(i, i + chunkSize);
+      await worker.transferToHeap(chunk, chunkPtr);
+      await worker.call('account__proving_key_reader_add_chunk', reader, chunkPtr, chunk.length);
+    }
+    await worker.call('bbfree', chunkPtr);
+    await worker.call('account__init_proving_key_from_reader', reader);
   }
 
   public async getKey() {